@@ -29,6 +29,7 @@ class REPL final
   private:
     libdocscript::runtime::Environment _env;
     libdocscript::StringStream _stream;
+    libdocscript::Parser _parser;
 
     bool prev_input_unfinished = false;
 };
@@ -38,6 +39,7 @@ class REPL final
 // +--------------------+
 
 REPL::REPL()
+  : _parser(_stream, _env)
 {
     libdocscript::runtime::initialize_environment(_env);
 }
@@ -65,15 +67,23 @@ REPL::run()
         }
 
         try {
+            // The parser keeps the unfinished expression, only the new line
+            // will be scanned
             if (prev_input_unfinished) {
                 _stream.push_back(user_input);
-                _stream.reset();
                 prev_input_unfinished = false;
             } else {
                 _stream.reset(user_input);
+                _parser.reset();
+            }
+
+            auto exprs = _parser.resume();
+            // Unfinished input or unclosed bracket
+            if (!_parser.finished()) {
+                prev_input_unfinished = true;
+                _stream.push_back("\n");
             }
 
-            auto exprs = libdocscript::Parser::parse(_stream, _env);
             for (const auto& e : exprs) {
                 auto value = libdocscript::Interpreter(_env).eval(e);
                 if (value.type() !=
@@ -81,18 +91,9 @@ REPL::run()
                     print(std::cout, value) << std::endl;
             }
         }
-        // Unfinished input
-        catch (const libdocscript::UnfinishedInput& e) {
-            prev_input_unfinished = true;
-            _stream.push_back("\n");
-        }
-        // Unfinished bracket
-        catch (const libdocscript::UnclosedList& e) {
-            prev_input_unfinished = true;
-            _stream.push_back("\n");
-        }
         // Another exception
         catch (const libdocscript::Exception& e) {
+            prev_input_unfinished = false;
             std::cerr << e.what() << std::endl;
         }
         // Fatal exception
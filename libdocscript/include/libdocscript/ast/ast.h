@@ -1,6 +1,7 @@
 #ifndef LIBDOCSCRIPT_AST_AST_H
 #define LIBDOCSCRIPT_AST_AST_H
 #include "libdocscript/exception.h"
+#include "libdocscript/utility/position.h"
 
 namespace libdocscript::ast {
 
@@ -33,8 +34,16 @@ class ASTNode
 
     ASTNodeType type() const;
 
+    ///
+    /// \brief The position of the first token of the node in the source,
+    ///        the line number 0 means the node is not from the source.
+    ///
+    const Position& position() const;
+    void set_position(const Position& pos);
+
   private:
     ASTNodeType _type;
+    Position _position;
 
     virtual ASTNode* rawptr_clone() const;
 };
@@ -3,7 +3,7 @@
 #include "libdocscript/ast/ast.h"
 #include "libdocscript/token.h"
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
 
 namespace libdocscript::ast {
@@ -49,6 +49,7 @@ class Atom final : public ASTNode
 
     static AtomType convert_type(TokenType type);
     static AtomType special_type(const std::string& content);
+    static std::string_view keyword(AtomType type);
 
   private:
     std::string _content;
@@ -72,21 +73,6 @@ class AtomHelper final
     AtomType get_type_by_content(const std::string& content) const;
     Atom create_by_type(AtomType t, std::string content = "") const;
     Atom create_emptyline_symbol() const;
-
-  private:
-    std::unordered_map<std::string, AtomType> _symbol_map = {
-        { "define", AtomType::Define },
-        { "set!", AtomType::Set },
-        { "lambda", AtomType::Lambda },
-        { "and", AtomType::LogicAnd },
-        { "or", AtomType::LogicOr },
-        { "if", AtomType::IfElse },
-        { "quote", AtomType::Quote },
-        { "quasiquote", AtomType::Quasiquote },
-        { "unquote", AtomType::Unquote },
-        { "unquote-splicing", AtomType::UnquoteSplicing },
-        { "define-macro", AtomType::DefineMacro },
-    };
 };
 } // namespace libdocscript::ast
 
@@ -1,16 +1,39 @@
 #ifndef LIBDOCSCRIPT_AST_LIST_H
 #define LIBDOCSCRIPT_AST_LIST_H
 #include "libdocscript/ast/ast.h"
+#include "libdocscript/ast/expression.h"
 #include "libdocscript/utility/position.h"
 #include "libdocscript/token.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+namespace libdocscript::runtime::specialform {
+class QuasiquotePlan;
+}
+
 namespace libdocscript::ast {
 class List : public ASTNode
 {
   public:
     using raw_type = std::vector<Expression>;
 
+    ///
+    /// \brief The macro expansion of the list at this call site. It is shared
+    ///        by the copies of the list, and valid while the macro has the
+    ///        same serial number. The quasiquote list keeps its compiled
+    ///        template here. The members are guarded by the mutex, as the
+    ///        list may be evaluated by several threads.
+    ///
+    struct Expansion
+    {
+        std::mutex mutex;
+        std::size_t macro_serial = 0;
+        std::shared_ptr<const Expression> expression;
+        std::shared_ptr<const runtime::specialform::QuasiquotePlan> quasiquote;
+    };
+
     bool is_textlist = false;
 
     List();
@@ -34,8 +57,16 @@ class List : public ASTNode
 
     Expression ptr_clone() const override;
 
+    ///
+    /// \brief Create the expansion cache if the list could be a macro call or
+    ///        a quasiquote, it should be done before the list be copied.
+    ///
+    void prepare_expansion_cache();
+    const std::shared_ptr<Expansion>& expansion_cache() const;
+
   private:
     raw_type _value;
+    std::shared_ptr<Expansion> _expansion;
 
     ASTNode* rawptr_clone() const override;
 };
@@ -24,13 +24,30 @@ class Exception : public std::exception
     inline const ExceptionType& get_type() const { return type; }
     inline const std::string& get_message() const { return message; }
 
+    ///
+    /// \brief Attach the source position where the exception raised, only the
+    ///        first known position will be kept.
+    ///
+    inline void locate(const Position& pos)
+    {
+        if (!_located && pos.line != 0) {
+            _located = true;
+            _position = pos;
+            _content.clear();
+        }
+    }
+    inline bool located() const { return _located; }
+    inline const Position& get_position() const { return _position; }
+
     inline const char* what() const override
     {
         if (_content.size() == 0) {
-            const_cast<Exception&>(*this)._content =
-              std::string(type == ExceptionType::Warning ? "warning: "
-                                                         : "error: ") +
-              message;
+            std::ostringstream oss;
+            if (_located)
+                oss << _position.to_string() << ":";
+            oss << (type == ExceptionType::Warning ? "warning: " : "error: ");
+            oss << message;
+            const_cast<Exception&>(*this)._content = oss.str();
         }
         return _content.c_str();
     }
@@ -40,6 +57,8 @@ class Exception : public std::exception
     std::string message;
 
   private:
+    bool _located = false;
+    Position _position;
     std::string _content;
 };
 
@@ -49,7 +68,9 @@ class InputException : public Exception
     InputException(ExceptionType t, const std::string& msg, Position pos)
       : Exception(t, msg)
       , position(pos)
-    {}
+    {
+        locate(pos);
+    }
 
     inline const char* what() const final
     {
@@ -276,6 +297,14 @@ class UnexceptType final : public Exception
     {}
 };
 
+class InvalidRegex final : public Exception
+{
+  public:
+    InvalidRegex(const std::string& msg)
+      : Exception(ExceptionType::Error, "invalid regular expression: " + msg)
+    {}
+};
+
 } // namespace libdocscript
 
 #endif
\ No newline at end of file
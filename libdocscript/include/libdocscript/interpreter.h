@@ -35,6 +35,7 @@ class Interpreter final
     // +--------------------+
 
     ast::Expression expand_macro(const ast::List& list);
+    runtime::Value eval_macro_calling(const ast::List& list);
 
     // +--------------------+
     //    Static Functions
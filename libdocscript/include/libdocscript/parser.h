@@ -3,9 +3,12 @@
 #include "libdocscript/ast/ast.h"
 #include "libdocscript/ast/expression.h"
 #include "libdocscript/ast/atom.h"
+#include "libdocscript/ast/list.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/scanner.h"
+#include "libdocscript/token.h"
 #include "libdocscript/utility/position.h"
+#include <exception>
 #include <vector>
 
 namespace libdocscript {
@@ -14,20 +17,62 @@ class Parser final
   public:
     using expression_list = std::vector<ast::Expression>;
 
+    Parser(StringStream& stream, runtime::Environment& env);
+
+    Parser(const Parser&) = delete;
+    Parser(Parser&&) = delete;
+    Parser& operator=(const Parser&) = delete;
+    Parser& operator=(Parser&&) = delete;
+
     static expression_list parse(StringStream &stream, runtime::Environment &env);
 
+    ///
+    /// \brief Parse the rest of the stream and return the finished
+    ///        expressions. The unfinished expression is kept, and it will be
+    ///        continued by the next call after more content pushed back to
+    ///        the stream.
+    ///
+    expression_list resume();
+
+    ///
+    /// \brief Throw the reason if there is an unfinished expression
+    ///
+    void finish() const;
+
+    bool finished() const;
+    void reset();
+
   private:
-    Scanner& _scanner;
+    enum class FrameType
+    {
+        List,
+        QuoteExpand
+    };
+
+    struct Frame
+    {
+        FrameType type;
+        TokenType close_bracket;
+        ast::List list;
+    };
+
+    Scanner _scanner;
     runtime::Environment& _env;
     static ast::AtomHelper _atom_helper;
 
-    Parser(Scanner &scanner, runtime::Environment &env);
+    std::vector<Frame> _frames;
+    bool _keyword_pending = false;
+    Token _keyword_token;
+    std::exception_ptr _scanner_unfinished;
+
+    void parse_token(const Token& token, expression_list& result);
+    void accept(ast::Expression expr, expression_list& result);
 
-    ast::Expression parse_expression(const Token& token);
+    ast::Expression parse_finished_list(ast::List list);
     ast::Atom parse_atom(const Token& token);
     ast::Atom parse_keyword(const Token& token);
-    ast::List parse_quote_expand(const Token& token);
-    ast::List parse_list(const Token& token);
+    Frame parse_quote_expand(const Token& token);
+    Frame parse_list(const Token& token);
     ast::Expression parse_text_element(const Token& token);
 };
 }
@@ -44,6 +44,37 @@ Value list_concat(args_list args, Environment &env);
 Value list_append(args_list args, Environment &env);
 Value list_empty_is(args_list args, Environment &env);
 
+Value list_map(args_list args, Environment &env);
+Value list_pmap(args_list args, Environment &env);
+Value list_filter(args_list args, Environment &env);
+Value list_fold(args_list args, Environment &env);
+Value list_for_each(args_list args, Environment &env);
+Value list_sort(args_list args, Environment &env);
+Value list_stable_sort(args_list args, Environment &env);
+
+// Table
+
+Value table_is(args_list args, Environment &env);
+Value table_make_table(args_list args, Environment &env);
+Value table_ref(args_list args, Environment &env);
+Value table_set(args_list args, Environment &env);
+Value table_has_is(args_list args, Environment &env);
+Value table_keys(args_list args, Environment &env);
+Value table_to_list(args_list args, Environment &env);
+
+// Vector
+
+Value vector_is(args_list args, Environment &env);
+Value vector_to_list(args_list args, Environment &env);
+Value list_to_vector(args_list args, Environment &env);
+
+Value vector_make_vector(args_list args, Environment &env);
+Value vector_(args_list args, Environment &env);
+Value vector_length(args_list args, Environment &env);
+Value vector_ref(args_list args, Environment &env);
+Value vector_set(args_list args, Environment &env);
+Value vector_push(args_list args, Environment &env);
+
 // Symbol
 
 Value symbol_is(args_list args, Environment &env);
@@ -56,6 +87,7 @@ Value string_is(args_list args, Environment &env);
 Value string_eq(args_list args, Environment &env);
 Value string_to_symbol(args_list args, Environment &env);
 Value string_to_boolean(args_list args, Environment &env);
+Value string_to_number(args_list args, Environment &env);
 
 Value string_make_string(args_list args, Environment &env);
 Value string_gt_is(args_list args, Environment &env);
@@ -68,6 +100,20 @@ Value string_rtrim(args_list args, Environment &env);
 Value string_trim(args_list args, Environment &env);
 Value string_split(args_list args, Environment &env);
 Value string_substring(args_list args, Environment &env);
+Value string_index(args_list args, Environment &env);
+Value string_contains_is(args_list args, Environment &env);
+Value string_count(args_list args, Environment &env);
+Value string_replace(args_list args, Environment &env);
+Value string_html_escape(args_list args, Environment &env);
+Value string_xml_escape(args_list args, Environment &env);
+Value string_tex_escape(args_list args, Environment &env);
+
+// Regex
+
+Value regex_match(args_list args, Environment &env);
+Value regex_search(args_list args, Environment &env);
+Value regex_replace(args_list args, Environment &env);
+Value regex_split(args_list args, Environment &env);
 
 // Number
 
@@ -122,11 +168,23 @@ Value number_log(args_list args, Environment &env);
 Value number_max(args_list args, Environment &env);
 Value number_min(args_list args, Environment &env);
 
+Value number_sum(args_list args, Environment &env);
+Value number_product(args_list args, Environment &env);
+Value number_list_max(args_list args, Environment &env);
+Value number_list_min(args_list args, Environment &env);
+
 Value number_floor(args_list args, Environment &env);
 Value number_ceiling(args_list args, Environment &env);
 Value number_truncate(args_list args, Environment &env);
 Value number_round(args_list args, Environment &env);
 
+// Port
+
+Value port_is(args_list args, Environment &env);
+Value port_open_output_string(args_list args, Environment &env);
+Value port_write_string(args_list args, Environment &env);
+Value port_get_output_string(args_list args, Environment &env);
+
 // Procedure
 
 Value procedure_is(args_list args, Environment &env);
@@ -3,6 +3,7 @@
 #include "libdocscript/proc/builtin.h"
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace libdocscript::proc {
@@ -19,8 +20,8 @@ class Utility final
     using func_num_multiple = std::function<Number(number_list)>;
 
     static std::vector<Number> convert_to_number_list(
-      std::vector<Value>::const_iterator beg,
-      std::vector<Value>::const_iterator end);
+      Arguments::const_iterator beg,
+      Arguments::const_iterator end);
 
     static Number number_func_helper(args_list args, func_num_1 func);
     static Number number_func_helper(args_list args, func_num_1_multiple func);
@@ -28,12 +29,28 @@ class Utility final
     static Number number_func_helper(args_list args, func_num_2_multiple func);
     static Number number_func_helper(args_list args, func_num_multiple func);
 
-    static std::string ltrim(const std::string&);
-    static std::string rtrim(const std::string&);
-    static std::string trim(const std::string&);
+    ///
+    /// \brief Call the procedure with the copies of arguments, the result
+    ///        may be unspecific.
+    ///
+    static Value invoke(const Procedure& proc,
+                        Environment& env,
+                        const Value& arg);
+    static Value invoke(const Procedure& proc,
+                        Environment& env,
+                        const Value& arg1,
+                        const Value& arg2);
 
-    static std::vector<std::string> split(const std::string& str,
-                                          const std::string& d);
+    ///
+    /// \brief The trimmed and the split parts are the views of the string
+    ///        without copying.
+    ///
+    static std::string_view ltrim(std::string_view str);
+    static std::string_view rtrim(std::string_view str);
+    static std::string_view trim(std::string_view str);
+
+    static std::vector<std::string_view> split(std::string_view str,
+                                               std::string_view d);
 };
 }
 
@@ -0,0 +1,108 @@
+#ifndef LIBDOCSCRIPT_RUNTIME_ARGUMENTS_H
+#define LIBDOCSCRIPT_RUNTIME_ARGUMENTS_H
+#include "libdocscript/runtime/value.h"
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace libdocscript::runtime {
+
+///
+/// \brief The view of the arguments of a procedure calling. The arguments
+///        belong to the calling, the procedure may move them away.
+///
+class Arguments final
+{
+  public:
+    using size_type = std::size_t;
+    using iterator = Value*;
+    using const_iterator = Value*;
+
+    Arguments();
+    Arguments(Value* first, size_type size);
+    Arguments(std::vector<Value>& values);
+
+    size_type size() const;
+    bool empty() const;
+
+    iterator begin() const;
+    iterator end() const;
+
+    Value& front() const;
+    Value& back() const;
+    Value& operator[](size_type index) const;
+
+  private:
+    Value* _first;
+    size_type _size;
+};
+
+///
+/// \brief The arguments of the procedure callings being evaluated in the
+///        thread. The stack is made of chunks which never move, so the
+///        arguments of the outer calling keep valid while the inner callings
+///        push theirs. The chunks are kept for the next callings.
+///
+class ArgumentStack final
+{
+  public:
+    using size_type = std::size_t;
+
+    ///
+    /// \brief The arguments of one calling, the slots for them are taken
+    ///        when the frame is created and given back when it is destroyed.
+    ///        No more than \p capacity arguments could be pushed.
+    ///
+    class Frame final
+    {
+      public:
+        Frame(ArgumentStack& stack, size_type capacity);
+        ~Frame();
+
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+        void push_back(Value&& val);
+        Arguments arguments() const;
+
+      private:
+        ArgumentStack& _stack;
+        size_type _prev_chunk;
+        size_type _chunk;
+        size_type _start;
+        size_type _size;
+
+        Value* slot(size_type index) const;
+    };
+
+    ArgumentStack() = default;
+    ArgumentStack(const ArgumentStack&) = delete;
+    ArgumentStack& operator=(const ArgumentStack&) = delete;
+
+    ///
+    /// \brief The argument stack of the current thread
+    ///
+    static ArgumentStack& current();
+
+  private:
+    using slot_type =
+      std::aligned_storage_t<sizeof(Value), alignof(Value)>;
+
+    struct Chunk
+    {
+        std::unique_ptr<slot_type[]> slots;
+        size_type capacity;
+        size_type top;
+    };
+
+    static constexpr size_type chunk_capacity = 1024;
+
+    std::vector<Chunk> _chunks;
+    size_type _active = 0;
+
+    size_type take(size_type count);
+};
+}
+
+#endif
\ No newline at end of file
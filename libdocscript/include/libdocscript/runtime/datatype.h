@@ -1,7 +1,10 @@
 #ifndef LIBDOCSCRIPT_RUNTIME_DATATYPE_H
 #define LIBDOCSCRIPT_RUNTIME_DATATYPE_H
 #include "libdocscript/exception.h"
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace libdocscript::runtime {
 
@@ -25,11 +28,15 @@ class DataType
         Number,
         String,
         List,
-        Procedure
+        Procedure,
+        Table,
+        Vector,
+        Port
     };
 
     DataType(DataType::Kind k);
     DataType(const DataType&) = default;
+    virtual ~DataType() = default;
 
     DataType& operator=(const DataType&) = delete;
     DataType& operator=(DataType&&) = delete;
@@ -43,6 +50,13 @@ class DataType
     Kind _kind;
 
     virtual DataType* rawptr_clone() const;
+
+    ///
+    /// \brief Construct the copy in the buffer of Value if the type is as
+    ///        small as Number, otherwise return nullptr and Value allocates
+    ///        the copy by rawptr_clone().
+    ///
+    virtual DataType* rawptr_clone_to(void* buffer) const;
 };
 
 class Unspecific final : public DataType
@@ -57,6 +71,7 @@ class Unspecific final : public DataType
 
   private:
     DataType* rawptr_clone() const override;
+    DataType* rawptr_clone_to(void* buffer) const override;
 };
 
 class Nil final : public DataType
@@ -71,6 +86,7 @@ class Nil final : public DataType
 
   private:
     DataType* rawptr_clone() const override;
+    DataType* rawptr_clone_to(void* buffer) const override;
 };
 
 class Error final : public DataType
@@ -118,6 +134,7 @@ class Boolean final : public DataType
   private:
     bool _value;
     DataType* rawptr_clone() const override;
+    DataType* rawptr_clone_to(void* buffer) const override;
 };
 
 class Number final : public DataType
@@ -143,6 +160,25 @@ class Number final : public DataType
 
     void cast_to(Type t);
 
+    ///
+    /// \brief Format the number by std::to_chars, without the locale and
+    ///        the stream. The integer is formatted in the radix from 2 to 36.
+    ///        The decimal is formatted in radix 10, in the shortest form
+    ///        that reads back as the same value (in fixed notation if its
+    ///        magnitude is from 1e-7 to below 1e21), or with precision digits
+    ///        after the decimal point if precision is not negative.
+    ///
+    std::string to_string(int radix = 10, int precision = -1) const;
+
+    ///
+    /// \brief Parse the whole text as a number by std::from_chars, it never
+    ///        throws or allocates. The text is an integer in the radix from 2
+    ///        to 36, a decimal in radix 10 (the integer out of range is read
+    ///        as a decimal too), or one of inf nan with optional sign. Return
+    ///        std::nullopt if the text is not a number.
+    ///
+    static std::optional<Number> parse(std::string_view text, int radix = 10);
+
     operator bool() const override;
     operator std::string() const override;
     operator int_type() const;
@@ -157,21 +193,55 @@ class Number final : public DataType
     } _value;
 
     DataType* rawptr_clone() const override;
+    DataType* rawptr_clone_to(void* buffer) const override;
 };
 
+///
+/// \brief The string is kept as a rope if it is not shorter than
+///        rope_threshold, the rope is a balanced tree of the chunks shared by
+///        the strings appended or cut from it. The rope is flattened only when
+///        the content is required as one std::string.
+///
+///        The part cut from a rope is a slice which refers the text of the
+///        rope without copying, even if it is short. The slice copies its
+///        content when it is changed, or when it is copied after the other
+///        strings that refer the text are gone.
+///
 class String final : public DataType
 {
   public:
+    using size_type = std::string::size_type;
+
+    static constexpr size_type rope_threshold = 1024;
+
     String(const std::string& str);
+    String(std::string&& str);
 
     std::string& value();
     const std::string& const_value() const;
+    size_type size() const;
+
+    ///
+    /// \brief The content without copying if the string is flat or a slice
+    ///
+    std::string_view view() const;
+
+    void append(const String& rhs);
+    String substr(size_type pos, size_type len = std::string::npos) const;
 
     operator bool() const override;
     operator std::string() const override;
 
   private:
+    struct Node;
+    using node_ptr = std::shared_ptr<const Node>;
+
     std::string _value;
+    node_ptr _rope;
+
+    String(node_ptr rope);
+
+    node_ptr to_node() const;
 
     DataType* rawptr_clone() const override;
 };
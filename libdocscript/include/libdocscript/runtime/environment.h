@@ -5,10 +5,10 @@
 #include "libdocscript/exception.h"
 #include "libdocscript/runtime/macro.h"
 #include "libdocscript/runtime/value.h"
-#include <memory>
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace libdocscript::runtime {
 
@@ -52,13 +52,36 @@ class Environment final
     Environment& parent();
     Environment& global();
 
+    ///
+    /// \brief Create an empty environment whose parent is this one. The
+    ///        parent is referred instead of copied, so deriving costs the
+    ///        same however many names are defined, and this environment must
+    ///        outlive the derived one.
+    ///
     Environment derive();
 
+    ///
+    /// \brief Create the environment of a lambda calling whose parameters
+    ///        are bound in place. The names are looked up in the parameter
+    ///        list, and their values are the slots of the arguments, so
+    ///        nothing is allocated for them. Both the names and the values
+    ///        must outlive the derived environment.
+    ///
+    Environment derive(const std::vector<std::string>& names, Value* values);
+
   private:
-    std::shared_ptr<Environment> _parent;
+    // Not owned, the parent outlives the derived environments
+    Environment* _parent = nullptr;
+
+    // The parameters bound in place, the names belong to the lambda and the
+    // values to the argument stack of the calling
+    const std::vector<std::string>* _frame_names = nullptr;
+    Value* _frame_values = nullptr;
 
     dict_type _value_dict;
 
+    Value* frame_slot(const std::string& name);
+
     static bool is_macro(const data_type&);
 };
 
@@ -3,26 +3,72 @@
 #include "libdocscript/runtime/datatype.h"
 #include "libdocscript/runtime/value.h"
 #include "libdocscript/runtime/list.h"
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 namespace libdocscript::runtime {
+///
+/// \brief The list of the numbers of the same type is packed, the integers
+///        or the decimals are kept in one contiguous buffer of the raw
+///        numbers instead of the values. The list is unpacked to the values
+///        once something else is added, or the values are required by raw(),
+///        craw() or the iterators; the packed buffer is kept when it is
+///        unpacked by the const functions, so a list shared by the threads
+///        can be read without the lock.
+///
 class List final : public DataType
 {
   public:
     using raw_type = std::vector<Value>;
+    using size_type = raw_type::size_type;
+
+    enum Storage
+    {
+        Generic,
+        Integers,
+        Decimals
+    };
 
     List();
 
     List(const raw_type &);
     List(raw_type::const_iterator beg, raw_type::const_iterator end);
 
+    ///
+    /// \brief The packed list of the integers or the decimals
+    ///
+    explicit List(std::vector<Number::int_type> integers);
+    explicit List(std::vector<Number::dec_type> decimals);
+
     List(const List &);
     List(List &&);
 
     raw_type &raw();
     const raw_type &craw() const;
 
-    raw_type::size_type size() const;
+    ///
+    /// \brief The representation of the elements, the packed buffer is
+    ///        integers() or decimals(). The empty list is Integers.
+    ///
+    Storage storage() const;
+    const std::vector<Number::int_type> &integers() const;
+    const std::vector<Number::dec_type> &decimals() const;
+
+    size_type size() const;
+
+    ///
+    /// \brief The element at pos, it doesn't unpack the list.
+    ///
+    Value at(size_type pos) const;
+
+    ///
+    /// \brief The list of the elements from pos to the end, it is packed if
+    ///        this list is packed.
+    ///
+    List sublist(size_type pos) const;
+
+    void reserve(size_type n);
 
     void push_back(const Value &val);
     void push_back(Value &&val);
@@ -36,7 +82,15 @@ class List final : public DataType
     operator std::string() const override;
 
   private:
-    std::vector<Value> _raw;
+    mutable std::atomic<Storage> _storage;
+    mutable std::once_flag _unpacked;
+    mutable std::vector<Value> _raw;
+    std::vector<Number::int_type> _integers;
+    std::vector<Number::dec_type> _decimals;
+
+    void pack(raw_type::const_iterator beg, raw_type::const_iterator end);
+    void unpack() const;
+    void drop_packed();
 
     DataType *rawptr_clone() const override;
 };
@@ -3,6 +3,7 @@
 #include "libdocscript/ast/atom.h"
 #include "libdocscript/ast/expression.h"
 #include "libdocscript/ast/list.h"
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -24,9 +25,18 @@ class Macro final
 
     const param_list& parameters() const;
 
+    ///
+    /// \brief Every definition of macro has a unique serial number, the copies
+    ///        of the macro share it.
+    ///
+    std::size_t serial() const;
+
   private:
     param_list _params;
     ast::Expression _expression;
+    std::size_t _serial;
+
+    static std::size_t next_serial();
 };
 } // namespace libdocscript
 
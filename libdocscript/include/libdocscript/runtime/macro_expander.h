@@ -5,6 +5,8 @@
 #include "libdocscript/ast/list.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/runtime/macro.h"
+#include <cstddef>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +18,29 @@ class MacroExpander final
     using args_map = std::unordered_map<std::string, ast::Expression>;
     using args_list = std::vector<ast::Expression>;
 
+    ///
+    /// \brief The limit of nested expansions, both the expansions chained by
+    ///        expand_all() and the expansions evaluated inside each other at
+    ///        run-time. The macro calling itself without end raises an error
+    ///        instead of overflowing the stack.
+    ///
+    static constexpr std::size_t max_depth = 256;
+
+    ///
+    /// \brief Count the run-time expansion that is being evaluated in this
+    ///        thread while it is alive, raise MacroExpandingFailed if there
+    ///        are more than max_depth.
+    ///
+    class DepthGuard final
+    {
+      public:
+        explicit DepthGuard(const std::string& name);
+        ~DepthGuard();
+
+        DepthGuard(const DepthGuard&) = delete;
+        DepthGuard& operator=(const DepthGuard&) = delete;
+    };
+
     ///
     /// \brief Expand the macro once, the nested macro will not be expanded
     ///
@@ -24,20 +49,32 @@ class MacroExpander final
                                     Environment& env);
     
     ///
-    /// \brief Expand the macro recursively, all macro inside will be expanded.
-    ///        IMPORTANT: THE SELF NESTED MACRO WILL MAKE STACK OVERFLOWED
+    /// \brief Expand the macro, and then expand all macros inside the result
+    ///        by expand_all().
     ///
     static ast::Expression expand(Macro& macro,
                                   const args_list& args,
                                   Environment& env);
 
+    ///
+    /// \brief Expand every macro calling inside the expression until there is
+    ///        no macro could be expanded. The arguments of a macro calling are
+    ///        expanded before the macro itself.
+    ///        The macro calling that appears again in the expansion of itself
+    ///        is left to be expanded at run-time, so that the self nested
+    ///        macro will not expand forever. The run-time expansion is limited
+    ///        by DepthGuard.
+    ///        The body of define-macro and quote will not be expanded, and only
+    ///        the unquote and unquote-splicing inside quasiquote are expanded.
+    ///
+    static ast::Expression expand_all(ast::Expression expr, Environment& env);
+
   private:
     Environment& _env;
     Macro& _macro;
-    bool _expand_recusrive;
     args_map &_args;
 
-    MacroExpander(Macro& macro, args_map& args, Environment& env, bool rec_expand);
+    MacroExpander(Macro& macro, args_map& args, Environment& env);
 
     ast::Expression expand_expression(const ast::Expression& expr);
     ast::Expression expand_atom(const ast::Atom& atom);
@@ -45,6 +82,15 @@ class MacroExpander final
 
     bool find_name(const std::string& name);
 
+    static bool is_macro_calling(const ast::Expression& expr, Environment& env);
+    static bool is_define_macro(const ast::Expression& expr);
+
+    ///
+    /// \brief The type of the first atom of the list, or Nil if it doesn't
+    ///        start with an atom.
+    ///
+    static ast::AtomType form_of(const ast::Expression& expr);
+
     static args_map create_map(const Macro::param_list &param, const args_list &args);
 };
 
@@ -1,17 +1,21 @@
 #ifndef LIBDOCSCRIPT_RUNTIME_PROCEDURE_H
 #define LIBDOCSCRIPT_RUNTIME_PROCEDURE_H
+#include "libdocscript/runtime/arguments.h"
 #include "libdocscript/runtime/datatype.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/ast/expression.h"
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
 #include <string>
-#include <functional>
+#include <vector>
 
 namespace libdocscript::runtime {
 class Procedure : public DataType
 {
   public:
-    using args_list = std::vector<Value>;
+    using args_list = Arguments;
 
     enum Type
     {
@@ -54,16 +58,62 @@ class LambdaProcedure final : public Procedure
 class BuiltInProcedure final : public Procedure
 {
   public:
-    using inner_type = std::function<Value(const args_list &, Environment&)>;
+    using inner_type = Value (*)(const args_list &, Environment&);
+
+    ///
+    /// \brief The number and the types of arguments, they are checked before
+    ///        the function is called. The first arguments have the kinds of
+    ///        their positions, and the others have the rest kind; any means
+    ///        the argument of any type.
+    ///
+    class Signature
+    {
+      public:
+        using kind_type = std::optional<DataType::Kind>;
+
+        static constexpr std::size_t variadic = static_cast<std::size_t>(-1);
+        static constexpr std::size_t max_positions = 3;
+        static constexpr kind_type any = std::nullopt;
+
+        Signature() = default;
+        Signature(std::size_t min_args, std::size_t max_args, kind_type rest);
+        Signature(std::size_t min_args,
+                  std::size_t max_args,
+                  std::initializer_list<kind_type> positions,
+                  kind_type rest = any);
+
+        std::size_t min_args() const;
+        std::size_t max_args() const;
+
+        ///
+        /// \brief The kind of the argument at the index.
+        ///
+        kind_type kind(std::size_t index) const;
+
+      private:
+        std::size_t _min_args = 0;
+        std::size_t _max_args = variadic;
+        std::array<kind_type, max_positions> _positions{};
+        std::size_t _position_count = 0;
+        kind_type _rest = any;
+    };
 
     BuiltInProcedure(inner_type func);
+    BuiltInProcedure(inner_type func, Signature signature);
 
+    ///
+    /// \brief Call the function in the environment of the caller, the
+    ///        built-in procedure never defines a name.
+    ///
     Value invoke(const args_list &args, Environment &env) const override;
 
     operator std::string() const override;
 
   private:
     inner_type _func;
+    Signature _signature;
+
+    void check_signature(const args_list &args) const;
 
     DataType *rawptr_clone() const override;
 };
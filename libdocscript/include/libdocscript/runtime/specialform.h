@@ -5,6 +5,7 @@
 #include "libdocscript/ast/list.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/runtime/value.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -115,6 +116,43 @@ class Quote final : public SpecialForm
 class Unquote;
 class UnquoteSplicing;
 
+///
+/// \brief The compiled template of quasiquote. The parts without unquote are
+///        built as values once, only the unquote and unquote-splicing
+///        expressions are evaluated when the plan is applied.
+///
+class QuasiquotePlan final
+{
+  public:
+    QuasiquotePlan(const ast::Expression& expr, Environment& env);
+
+    Value operator()(Environment& env) const;
+
+  private:
+    enum class SegmentType
+    {
+        Constant,
+        Unquote,
+        Splicing,
+        List
+    };
+
+    struct Segment
+    {
+        SegmentType type;
+        std::shared_ptr<const Value> constant;
+        std::shared_ptr<const ast::Expression> expr;
+        std::vector<Segment> elements;
+    };
+
+    Segment _root;
+
+    static Segment compile(const ast::Expression& expr,
+                           Environment& env,
+                           int depth);
+    static Value apply(const Segment& segment, Environment& env);
+};
+
 class Quasiquote final : public SpecialForm
 {
   public:
@@ -122,19 +160,11 @@ class Quasiquote final : public SpecialForm
 
     Value operator()(Environment& env) override;
 
-    static Value process(const ast::Expression& expr,
-                         Environment& env,
-                         int depth);
-    static Value process_list(const ast::List& list,
-                              Environment& env,
-                              int depth);
-
     static bool is_unquote(const ast::List& list);
     static bool is_splicing(const ast::List& list);
-    static bool is_inner_splicing(const ast::List& list);
 
   private:
-    ast::Expression _expr;
+    const ast::List& _list;
 };
 
 class Unquote final : public SpecialForm
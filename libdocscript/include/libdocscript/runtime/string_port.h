@@ -0,0 +1,52 @@
+#ifndef LIBDOCSCRIPT_RUNTIME_STRING_PORT_H
+#define LIBDOCSCRIPT_RUNTIME_STRING_PORT_H
+#include "libdocscript/runtime/datatype.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libdocscript::runtime {
+
+///
+/// \brief The output port collects the written strings. The content is kept
+///        in chunks which are never moved once they are filled, so writing
+///        does not copy what was written before. The copies of a port share
+///        the content like Table.
+///
+class StringPort final : public DataType
+{
+  public:
+    using size_type = std::string::size_type;
+
+    StringPort();
+
+    void write(std::string_view str);
+
+    ///
+    /// \brief Return all content written in the port
+    ///
+    std::string str() const;
+    size_type size() const;
+
+    operator bool() const override;
+    operator std::string() const override;
+
+  private:
+    static constexpr size_type chunk_capacity = 64 * 1024;
+
+    struct Buffer
+    {
+        std::vector<std::string> chunks;
+        size_type size = 0;
+    };
+
+    std::shared_ptr<Buffer> _buffer;
+
+    friend class Value;
+    DataType* rawptr_clone() const override;
+};
+}
+
+#endif
\ No newline at end of file
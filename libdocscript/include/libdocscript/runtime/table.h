@@ -0,0 +1,70 @@
+#ifndef LIBDOCSCRIPT_RUNTIME_TABLE_H
+#define LIBDOCSCRIPT_RUNTIME_TABLE_H
+#include "libdocscript/runtime/datatype.h"
+#include "libdocscript/runtime/value.h"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace libdocscript::runtime {
+
+///
+/// \brief The hash table from keys to values, the keys are the same if they
+///        are equal by Value::operator==. The copies of a table share the
+///        entries, so the table updated by a procedure is seen by the caller.
+///        The entries keep the order they are inserted.
+///
+class Table final : public DataType
+{
+  public:
+    using size_type = std::size_t;
+    using entry_type = std::pair<Value, Value>;
+    using raw_type = std::vector<entry_type>;
+
+    Table();
+
+    const raw_type& craw() const;
+    size_type size() const;
+
+    ///
+    /// \brief Return the value of the key, or nullptr if there is no entry
+    ///        of the key.
+    ///
+    const Value* find(const Value& key) const;
+
+    ///
+    /// \brief Set the value of the key. Raise RuntimeError if the key is or
+    ///        contains NaN, which is never equal to itself.
+    ///
+    void set(const Value& key, const Value& val);
+
+    operator bool() const override;
+    operator std::string() const override;
+
+  private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Value& key) const;
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const Value& lhs, const Value& rhs) const;
+    };
+
+    struct Entries
+    {
+        raw_type entries;
+        std::unordered_map<Value, size_type, KeyHash, KeyEqual> index;
+    };
+
+    std::shared_ptr<Entries> _entries;
+
+    friend class Value;
+    DataType* rawptr_clone() const override;
+};
+}
+
+#endif
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define LIBDOCSCRIPT_RUNTIME_VALUE_H
 #include "libdocscript/exception.h"
 #include "libdocscript/runtime/datatype.h"
-#include <typeinfo>
+#include <cstddef>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
 
 namespace libdocscript::runtime {
 class Value final
@@ -38,11 +40,29 @@ class Value final
 
     operator bool() const;
     operator std::string() const;
-    bool operator==(const Value &rhs);
-    bool operator!=(const Value &rhs);
+    bool operator==(const Value &rhs) const;
+    bool operator!=(const Value &rhs) const;
+
+    ///
+    /// \brief The hash of the value, the values equal by operator== have
+    ///        the same hash.
+    ///
+    std::size_t hash() const;
 
   private:
+    // The small data type (no larger than Number) is stored in the value
+    // itself, so the list of them keeps its elements together without
+    // allocating each one.
+    using storage_type =
+      std::aligned_storage_t<sizeof(Number), alignof(Number)>;
+
     DataType* _ptr;
+    bool _is_inline;
+    storage_type _storage;
+
+    void assign(const DataType& dt);
+    void take(Value&& val);
+    void release();
 };
 }
 
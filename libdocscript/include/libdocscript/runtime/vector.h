@@ -0,0 +1,38 @@
+#ifndef LIBDOCSCRIPT_RUNTIME_VECTOR_H
+#define LIBDOCSCRIPT_RUNTIME_VECTOR_H
+#include "libdocscript/runtime/datatype.h"
+#include "libdocscript/runtime/value.h"
+#include <memory>
+#include <vector>
+
+namespace libdocscript::runtime {
+
+///
+/// \brief The array of values which could be updated in place. The copies of
+///        a vector share the elements like Table, so the vector updated by a
+///        procedure is seen by the caller.
+///
+class Vector final : public DataType
+{
+  public:
+    using raw_type = std::vector<Value>;
+
+    Vector();
+    Vector(raw_type::const_iterator beg, raw_type::const_iterator end);
+
+    raw_type& raw();
+    const raw_type& craw() const;
+    raw_type::size_type size() const;
+
+    operator bool() const override;
+    operator std::string() const override;
+
+  private:
+    std::shared_ptr<raw_type> _raw;
+
+    friend class Value;
+    DataType* rawptr_clone() const override;
+};
+}
+
+#endif
\ No newline at end of file
@@ -39,7 +39,7 @@ class Position final
     {}
     ~Position() = default;
 
-    inline PositionDiff operator-(const Position& rhs)
+    inline PositionDiff operator-(const Position& rhs) const
     {
         return PositionDiff(line - rhs.line, column - rhs.column);
     }
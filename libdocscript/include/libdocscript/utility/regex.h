@@ -0,0 +1,92 @@
+#ifndef LIBDOCSCRIPT_UTILITY_REGEX_H
+#define LIBDOCSCRIPT_UTILITY_REGEX_H
+#include <bitset>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace libdocscript {
+
+///
+/// \brief The regular expression compiled to the program of Pike's virtual
+///        machine. All alternatives are run together in one pass of the
+///        text, so the time is linear in the size of the text and never
+///        backtracks.
+///
+///        Supported syntax (bytes, not UTF-8 characters): literals, `.',
+///        [...] [^...] with ranges, \d \D \w \W \s \S, \b \B, ^ $, (...),
+///        (?:...), |, and the quantifiers * + ? {n} {n,} {n,m} with the
+///        lazy form followed by `?'. The `{' which doesn't begin a counted
+///        quantifier is a literal. The quantifiers can't be stacked, and the
+///        groups are nested 256 levels at most.
+///
+class Regex final
+{
+  public:
+    using size_type = std::string_view::size_type;
+
+    static constexpr size_type npos = std::string_view::npos;
+
+    ///
+    /// \brief The begin and the end positions of the match (group 0) and of
+    ///        the groups, they are npos if the group doesn't participate.
+    ///
+    using Match = std::vector<size_type>;
+
+    explicit Regex(std::string_view pattern);
+
+    ///
+    /// \brief The number of groups, including the whole match
+    ///
+    size_type groups() const;
+
+    ///
+    /// \brief Match the whole text
+    ///
+    bool match(std::string_view text, Match& result) const;
+
+    ///
+    /// \brief Search the leftmost match which begins from pos or after it
+    ///
+    bool search(std::string_view text, size_type pos, Match& result) const;
+
+  private:
+    enum class Opcode
+    {
+        Char,
+        Any,
+        Class,
+        Split,
+        Jump,
+        Save,
+        Begin,
+        End,
+        WordBoundary,
+        NotWordBoundary,
+        Match
+    };
+
+    struct Instruction
+    {
+        Opcode op;
+        unsigned char ch = 0;
+        // The targets of Split and Jump, the preferred one is x. The index of
+        // class for Class and the slot for Save are x too.
+        size_type x = 0;
+        size_type y = 0;
+    };
+
+    class Compiler;
+
+    std::vector<Instruction> _program;
+    std::vector<std::bitset<256>> _classes;
+    size_type _groups;
+
+    bool run(std::string_view text,
+             size_type pos,
+             bool whole,
+             Match& result) const;
+};
+}
+
+#endif
\ No newline at end of file
@@ -33,6 +33,9 @@ class BasicStringStream
     virtual void push_back(char) = 0;
     virtual void push_back(const std::string&) = 0;
 
+    virtual void mark() = 0;
+    virtual void rewind() = 0;
+
     virtual operator bool() const = 0;
 };
 
@@ -59,6 +62,9 @@ class StringStream final : public BasicStringStream
     void push_back(char) override;
     void push_back(const std::string&) override;
 
+    void mark() override;
+    void rewind() override;
+
     operator bool() const override;
 
   private:
@@ -70,6 +76,13 @@ class StringStream final : public BasicStringStream
     Position _pos;
     std::stack<Position::value_type> _line_col_cnt;
 
+    struct Mark
+    {
+        std::string::size_type offset = 0;
+        Position position = Position(1, 1);
+        std::stack<Position::value_type>::size_type line_cnt = 0;
+    } _mark;
+
     void increase_position();
     void decrease_position();
 };
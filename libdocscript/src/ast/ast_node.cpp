@@ -18,10 +18,12 @@ ASTNode::ASTNode(ASTNodeType t)
 
 ASTNode::ASTNode(const ASTNode& node)
   : _type(node._type)
+  , _position(node._position)
 {}
 
 ASTNode::ASTNode(ASTNode&& node)
   : _type(node._type)
+  , _position(node._position)
 {}
 
 // +----------------------+
@@ -40,6 +42,18 @@ ASTNode::type() const
     return _type;
 }
 
+const Position&
+ASTNode::position() const
+{
+    return _position;
+}
+
+void
+ASTNode::set_position(const Position& pos)
+{
+    _position = pos;
+}
+
 // +----------------------+
 //     Private Functions
 // +----------------------+
@@ -2,11 +2,85 @@
 #include "libdocscript/ast/expression.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/token.h"
-#include <unordered_map>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace libdocscript::ast {
 
+// +----------------------+
+//     Special Keywords
+// +----------------------+
+
+namespace {
+
+struct Keyword
+{
+    std::string_view name;
+    AtomType type;
+};
+
+constexpr Keyword keyword_list[] = {
+    { "define", AtomType::Define },
+    { "set!", AtomType::Set },
+    { "lambda", AtomType::Lambda },
+    { "and", AtomType::LogicAnd },
+    { "or", AtomType::LogicOr },
+    { "if", AtomType::IfElse },
+    { "quote", AtomType::Quote },
+    { "quasiquote", AtomType::Quasiquote },
+    { "unquote", AtomType::Unquote },
+    { "unquote-splicing", AtomType::UnquoteSplicing },
+    { "define-macro", AtomType::DefineMacro }
+};
+
+constexpr std::size_t keyword_slot_size = 32;
+
+// The content must not be empty
+constexpr std::size_t
+keyword_hash(std::string_view content)
+{
+    return (content.size() + static_cast<unsigned char>(content.front()) +
+            static_cast<unsigned char>(content.back())) %
+           keyword_slot_size;
+}
+
+struct KeywordTable
+{
+    Keyword slots[keyword_slot_size];
+    std::size_t min_size;
+    std::size_t max_size;
+    bool perfect;
+};
+
+constexpr KeywordTable
+make_keyword_table()
+{
+    KeywordTable table{};
+    table.min_size = keyword_list[0].name.size();
+    table.max_size = keyword_list[0].name.size();
+    table.perfect = true;
+    for (const auto& keyword : keyword_list) {
+        auto& slot = table.slots[keyword_hash(keyword.name)];
+        if (!slot.name.empty())
+            table.perfect = false;
+        slot = keyword;
+
+        if (keyword.name.size() < table.min_size)
+            table.min_size = keyword.name.size();
+        if (keyword.name.size() > table.max_size)
+            table.max_size = keyword.name.size();
+    }
+    return table;
+}
+
+constexpr KeywordTable keyword_table = make_keyword_table();
+
+static_assert(keyword_table.perfect,
+              "keywords collided in keyword_table, change keyword_hash()");
+
+} // namespace
+
 // +----------------------+
 //       Constructor
 // +----------------------+
@@ -20,6 +94,7 @@ Atom::Atom(AtomType t, const std::string& c)
 Atom::Atom(Token t)
   : ASTNode(ASTNodeType::Atom)
 {
+    set_position(t.position);
     _content = t.content;
     if (t.type == TokenType::Identifier) {
         _type = special_type(_content);
@@ -33,13 +108,13 @@ Atom::Atom(Token t)
 // +----------------------+
 
 Atom::Atom(const Atom& atom)
-  : ASTNode(ASTNodeType::Atom)
+  : ASTNode(atom)
   , _content(atom._content)
   , _type(atom._type)
 {}
 
 Atom::Atom(Atom&& atom)
-  : ASTNode(ASTNodeType::Atom)
+  : ASTNode(atom)
   , _content(atom._content)
   , _type(atom._type)
 {}
@@ -106,25 +181,25 @@ Atom::convert_type(TokenType type)
 AtomType
 Atom::special_type(const std::string& content)
 {
-    std::unordered_map<std::string, AtomType> dict{
-        { "define", AtomType::Define },
-        { "set!", AtomType::Set },
-        { "lambda", AtomType::Lambda },
-        { "and", AtomType::LogicAnd },
-        { "or", AtomType::LogicOr },
-        { "if", AtomType::IfElse },
-        { "quote", AtomType::Quote },
-        { "quasiquote", AtomType::Quasiquote },
-        { "unquote", AtomType::Unquote },
-        { "unquote-splicing", AtomType::UnquoteSplicing },
-        { "define-macro", AtomType::DefineMacro }
-    };
-
-    auto iter = dict.find(content);
-    if (iter == dict.end())
+    if (content.size() < keyword_table.min_size ||
+        content.size() > keyword_table.max_size)
+        return AtomType::Symbol;
+
+    const auto& slot = keyword_table.slots[keyword_hash(content)];
+    if (slot.name != content)
         return AtomType::Symbol;
     else
-        return iter->second;
+        return slot.type;
+}
+
+std::string_view
+Atom::keyword(AtomType type)
+{
+    for (const auto& keyword : keyword_list) {
+        if (keyword.type == type)
+            return keyword.name;
+    }
+    return std::string_view();
 }
 
 } // namespace libdocscript::ast
\ No newline at end of file
@@ -1,8 +1,7 @@
 #include "libdocscript/ast/atom.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/token.h"
-#include <unordered_map>
-#include <algorithm>
+#include <string>
 
 namespace libdocscript::ast {
 
@@ -26,28 +25,17 @@ AtomHelper::get_type_by_token_type(TokenType tt) const
 AtomType
 AtomHelper::get_type_by_content(const std::string& content) const
 {
-    auto iter =
-      std::find_if(_symbol_map.begin(),
-                   _symbol_map.end(),
-                   [&](const auto& pair) { return pair.first == content; });
-    if (iter == _symbol_map.end()) {
-        return AtomType::Symbol;
-    } else {
-        return iter->second;
-    }
+    return Atom::special_type(content);
 }
 
 Atom
 AtomHelper::create_by_type(AtomType t, std::string content) const
 {
-    auto iter =
-      std::find_if(_symbol_map.begin(),
-                   _symbol_map.end(),
-                   [&](const auto& pair) { return pair.second == t; });
-    if (iter == _symbol_map.end()) {
+    auto keyword = Atom::keyword(t);
+    if (keyword.empty()) {
         return Atom(t, content);
     } else {
-        return Atom(t, iter->first);
+        return Atom(t, std::string(keyword));
     }
 }
 
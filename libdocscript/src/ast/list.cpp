@@ -1,6 +1,7 @@
 #include "libdocscript/ast/list.h"
 #include "libdocscript/ast/atom.h"
 #include "libdocscript/ast/expression.h"
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -19,8 +20,9 @@ List::List()
 // +----------------------+
 
 List::List(const List& list)
-  : ASTNode(ASTNodeType::List)
+  : ASTNode(list)
   , is_textlist(list.is_textlist)
+  , _expansion(list._expansion)
 {
     for (auto p : list.craw()) {
         _value.push_back(p);
@@ -28,8 +30,9 @@ List::List(const List& list)
 }
 
 List::List(List&& list)
-  : ASTNode(ASTNodeType::List)
+  : ASTNode(list)
   , is_textlist(list.is_textlist)
+  , _expansion(list._expansion)
 {
     for (auto p : list.craw()) {
         _value.push_back(std::move(p));
@@ -86,6 +89,26 @@ List::is_empty() const
     return _value.empty();
 }
 
+void
+List::prepare_expansion_cache()
+{
+    if (is_textlist || _expansion || _value.empty())
+        return;
+
+    const auto& first = _value.front();
+    if (first.type() == ASTNodeType::Atom &&
+        (first.c_cast<Atom>().atom_type() == AtomType::Symbol ||
+         first.c_cast<Atom>().atom_type() == AtomType::Quasiquote)) {
+        _expansion = std::make_shared<Expansion>();
+    }
+}
+
+const std::shared_ptr<List::Expansion>&
+List::expansion_cache() const
+{
+    return _expansion;
+}
+
 List::raw_type::iterator
 List::begin()
 {
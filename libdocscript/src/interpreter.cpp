@@ -3,11 +3,13 @@
 #include "libdocscript/ast/expression.h"
 #include "libdocscript/ast/list.h"
 #include "libdocscript/exception.h"
+#include "libdocscript/runtime/arguments.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/runtime/list.h"
 #include "libdocscript/runtime/macro_expander.h"
 #include "libdocscript/runtime/specialform.h"
-#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,10 +30,16 @@ Interpreter::Interpreter(runtime::Environment& env)
 runtime::Value
 Interpreter::eval(const ast::Expression& expr)
 {
-    if (expr.type() == ast::ASTNodeType::Atom) {
-        return eval_atom(expr.c_cast<ast::Atom>());
-    } else {
-        return eval_list(expr.c_cast<ast::List>());
+    try {
+        if (expr.type() == ast::ASTNodeType::Atom) {
+            return eval_atom(expr.c_cast<ast::Atom>());
+        } else {
+            return eval_list(expr.c_cast<ast::List>());
+        }
+    } catch (Exception& e) {
+        // The innermost expression that has a position reports the error
+        e.locate((*expr).position());
+        throw;
     }
 }
 
@@ -93,28 +101,12 @@ Interpreter::eval_string(const ast::Atom& atom)
 runtime::Number
 Interpreter::eval_number(const ast::Atom& atom)
 {
-    auto content = atom.content();
-    if (content == "inf" || content == "+inf") {
-        return runtime::Number(
-          std::numeric_limits<runtime::Number::dec_type>::infinity());
-    }
-    if (content == "-inf") {
-        return runtime::Number(
-          -1 * std::numeric_limits<runtime::Number::dec_type>::infinity());
-    }
-    if (content == "nan" || content == "+nan") {
-        return runtime::Number(
-          std::numeric_limits<runtime::Number::dec_type>::signaling_NaN());
-    }
-    if (content == "-nan") {
-        return runtime::Number(
-          -1 * std::numeric_limits<runtime::Number::dec_type>::signaling_NaN());
-    }
-    if (content.find('.') == content.npos) {
-        return runtime::Number(std::stoll(content));
-    } else {
-        return runtime::Number(std::stold(content));
-    }
+    // The literal is checked by the scanner, the one failed to parse is a
+    // bug of it
+    if (auto num = runtime::Number::parse(atom.content()))
+        return *num;
+    throw InternalParsingException("invalid number literal: " +
+                                   atom.content());
 }
 
 runtime::Value
@@ -138,8 +130,7 @@ Interpreter::eval_list(const ast::List& list)
             if (atom.atom_type() == ast::AtomType::Symbol) {
                 // If symbol bound a macro : Macro Expanding
                 if (_env.find<runtime::Macro>(atom.content())) {
-                    auto expr = expand_macro(list);
-                    return eval(expr);
+                    return eval_macro_calling(list);
                 }
                 // Otherwise
                 else {
@@ -172,18 +163,20 @@ Interpreter::eval_procedure_calling(const ast::List& list)
     if (first_elem.type() != runtime::DataType::Kind::Procedure)
         throw NotProcedure();
 
-    runtime::Procedure::args_list args;
+    runtime::ArgumentStack::Frame args(runtime::ArgumentStack::current(),
+                                       list.size() - 1);
 
     for (auto beg = list.cbegin() + 1; beg != list.cend(); ++beg) {
         auto arg = eval(*beg);
         if (arg.type() == runtime::DataType::Kind::Unspecific) {
             throw DefinitionException();
         } else {
-            args.push_back(arg);
+            args.push_back(std::move(arg));
         }
     }
 
-    return first_elem.cast<runtime::Procedure>().invoke(args, _env);
+    return first_elem.cast<runtime::Procedure>().invoke(args.arguments(),
+                                                        _env);
 }
 
 runtime::Value
@@ -239,6 +232,34 @@ Interpreter::eval_special_form(const ast::List& list)
 //         Macro
 // +-----------------------+
 
+runtime::Value
+Interpreter::eval_macro_calling(const ast::List& list)
+{
+    // The expansion may call the macro again at run-time
+    runtime::MacroExpander::DepthGuard guard(
+      list.cbegin()->c_cast<ast::Atom>().content());
+
+    auto cache = list.expansion_cache();
+    if (!cache) {
+        return eval(expand_macro(list));
+    }
+
+    auto& macro =
+      _env.get<runtime::Macro>(list.cbegin()->c_cast<ast::Atom>().content());
+    // Keep the expansion alive, the macro may be redefined while evaluating
+    std::shared_ptr<const ast::Expression> expr;
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if (cache->macro_serial != macro.serial()) {
+            cache->expression =
+              std::make_shared<const ast::Expression>(expand_macro(list));
+            cache->macro_serial = macro.serial();
+        }
+        expr = cache->expression;
+    }
+    return eval(*expr);
+}
+
 ast::Expression
 Interpreter::expand_macro(const ast::List& list)
 {
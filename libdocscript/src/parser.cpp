@@ -6,8 +6,11 @@
 #include "libdocscript/interpreter.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/runtime/macro.h"
+#include "libdocscript/runtime/macro_expander.h"
 #include "libdocscript/scanner.h"
 #include "libdocscript/utility/stringstream.h"
+#include <exception>
+#include <utility>
 #include <vector>
 
 namespace libdocscript {
@@ -24,9 +27,9 @@ ast::AtomHelper Parser::_atom_helper;
 //      Constructor
 // +-------------------+
 
-Parser::Parser(Scanner& s, runtime::Environment& e)
-  : _scanner(s)
-  , _env(e)
+Parser::Parser(StringStream& stream, runtime::Environment& env)
+  : _scanner(stream)
+  , _env(env)
 {}
 
 // +-------------------+
@@ -36,69 +39,129 @@ Parser::Parser(Scanner& s, runtime::Environment& e)
 Parser::expression_list
 Parser::parse(StringStream& stream, runtime::Environment& env)
 {
-    Scanner scanner = Scanner(stream);
-    Parser parser = Parser(scanner, env);
+    Parser parser(stream, env);
+    auto result = parser.resume();
+    parser.finish();
+    return result;
+}
+
+// +-------------------+
+//   Public Functions
+// +-------------------+
+
+Parser::expression_list
+Parser::resume()
+{
     expression_list result;
-    while (parser._scanner) {
-        auto t = parser._scanner.get();
+    _scanner_unfinished = nullptr;
+    while (_scanner) {
+        Token t;
+        try {
+            t = _scanner.get();
+        } catch (const UnfinishedInput&) {
+            // The scanner has rewound to the beginning of the token
+            _scanner_unfinished = std::current_exception();
+            break;
+        }
         if (t == TokenType::Whitespace || t == TokenType::Comment) {
             continue;
         } else {
-            result.push_back(parser.parse_expression(t));
+            parse_token(t, result);
         }
     }
     return result;
 }
 
+void
+Parser::finish() const
+{
+    if (_scanner_unfinished) {
+        std::rethrow_exception(_scanner_unfinished);
+    }
+    if (_keyword_pending) {
+        throw UnfinishedInput("unfinished keyword", _keyword_token.position);
+    }
+    if (!_frames.empty()) {
+        const auto& frame = _frames.back();
+        if (frame.type == FrameType::List) {
+            throw UnclosedList(stringify(frame.close_bracket));
+        } else {
+            throw UnfinishedInput(
+              "unfinished quote / quasiquote / unquote delcaration",
+              frame.list.position());
+        }
+    }
+}
+
+bool
+Parser::finished() const
+{
+    return !_scanner_unfinished && !_keyword_pending && _frames.empty();
+}
+
+void
+Parser::reset()
+{
+    _scanner.reset();
+    _frames.clear();
+    _keyword_pending = false;
+    _scanner_unfinished = nullptr;
+}
+
 // +-------------------+
 //   Private Functions
 // +-------------------+
 
-Expression
-Parser::parse_expression(const Token& token)
+void
+Parser::parse_token(const Token& token, expression_list& result)
 {
+    if (_keyword_pending) {
+        _keyword_pending = false;
+        auto atom = parse_keyword(token);
+        atom.set_position(_keyword_token.position);
+        return accept(atom, result);
+    }
+
     switch (token.type) {
         case TokenType::Identifier:
         case TokenType::String:
         case TokenType::Number:
         case TokenType::Boolean:
-            return parse_atom(token);
+            return accept(parse_atom(token), result);
 
         case TokenType::TextContent:
         case TokenType::TextEmptyLine:
-            return parse_text_element(token);
+            return accept(parse_text_element(token), result);
 
         case TokenType::SymbolBracketCurlyLeft:
         case TokenType::SymbolBracketRoundLeft:
-        case TokenType::SymbolBracketSquareLeft: {
-            auto list = parse_list(token);
-            if (!list.is_empty() && list.begin()->type() == ASTNodeType::Atom) {
-                const auto& first = list.begin()->cast<Atom>();
-                // define-macro
-                if (first.atom_type() == AtomType::DefineMacro) {
-                    Interpreter(_env).eval_special_form(list);
-                }
-                // macro expanding
-                if (first.atom_type() == AtomType::Symbol &&
-                    _env.find<runtime::Macro>(first.content())) {
-                    return Interpreter(_env).expand_macro(list);
-                }
-            }
-            return list;
-        }
+        case TokenType::SymbolBracketSquareLeft:
+            _frames.push_back(parse_list(token));
+            return;
 
         case TokenType::SymbolQuote:
         case TokenType::SymbolBackquote:
         case TokenType::SymbolComma:
         case TokenType::SymbolCommaAt:
-            return parse_quote_expand(token);
+            _frames.push_back(parse_quote_expand(token));
+            return;
 
         case TokenType::SymbolHash:
-            return parse_keyword(token);
+            _keyword_pending = true;
+            _keyword_token = token;
+            return;
 
         case TokenType::SymbolBracketCurlyRight:
         case TokenType::SymbolBracketRoundRight:
         case TokenType::SymbolBracketSquareRight:
+            if (!_frames.empty() &&
+                _frames.back().type == FrameType::List &&
+                _frames.back().close_bracket == token.type) {
+                auto list = std::move(_frames.back().list);
+                _frames.pop_back();
+                return accept(parse_finished_list(std::move(list)), result);
+            }
+            [[fallthrough]];
         case TokenType::Undefined:
         default:
             throw InternalParsingException(
@@ -106,6 +169,38 @@ Parser::parse_expression(const Token& token)
     }
 }
 
+void
+Parser::accept(Expression expr, expression_list& result)
+{
+    while (!_frames.empty()) {
+        auto& frame = _frames.back();
+        frame.list.push_back(std::move(expr));
+        if (frame.type == FrameType::List) {
+            return;
+        }
+        // The quote expanding list is finished by its only expression
+        frame.list.prepare_expansion_cache();
+        expr = std::move(frame.list);
+        _frames.pop_back();
+    }
+    // Expand the whole top-level expression at once
+    result.push_back(runtime::MacroExpander::expand_all(std::move(expr), _env));
+}
+
+Expression
+Parser::parse_finished_list(ast::List list)
+{
+    if (!list.is_empty() && list.begin()->type() == ASTNodeType::Atom) {
+        const auto& first = list.begin()->cast<Atom>();
+        // define-macro
+        if (first.atom_type() == AtomType::DefineMacro) {
+            Interpreter(_env).eval_special_form(list);
+        }
+    }
+    list.prepare_expansion_cache();
+    return list;
+}
+
 ast::Atom
 Parser::parse_atom(const Token& token)
 {
@@ -113,14 +208,9 @@ Parser::parse_atom(const Token& token)
 }
 
 ast::Atom
-Parser::parse_keyword(const Token& token)
+Parser::parse_keyword(const Token& next_token)
 {
-    if (!_scanner) {
-        throw UnfinishedInput("unfinished keyword", token.position);
-    }
-
-    auto next_token = _scanner.get();
-    auto pos_diff = next_token.position - token.position;
+    auto pos_diff = next_token.position - _keyword_token.position;
     if (next_token.type != TokenType::Identifier ||
         !(pos_diff.line == 0 && pos_diff.column == 1)) {
         throw IllegalKeyword();
@@ -150,10 +240,12 @@ Parser::parse_keyword(const Token& token)
     }
 }
 
-ast::List
+Parser::Frame
 Parser::parse_quote_expand(const Token& token)
 {
-    List result;
+    Frame frame{ FrameType::QuoteExpand, TokenType::Undefined, ast::List() };
+    auto& result = frame.list;
+    result.set_position(token.position);
 
     // QUOTE
     if (token.type == TokenType::SymbolQuote) {
@@ -170,69 +262,46 @@ Parser::parse_quote_expand(const Token& token)
         result.push_back(
           _atom_helper.create_by_type(AtomType::UnquoteSplicing));
     }
+    result.begin()->cast<Atom>().set_position(token.position);
 
-    if (!_scanner) {
-        throw UnfinishedInput(
-          "unfinished quote / quasiquote / unquote delcaration",
-          token.position);
-    }
-
-    while (_scanner) {
-        auto t = _scanner.get();
-        if (t.type == TokenType::Whitespace || t.type == TokenType::Comment) {
-            continue;
-        } else {
-            result.push_back(parse_expression(t));
-            break;
-        }
-    }
-
-    return result;
+    return frame;
 }
 
-ast::List
+Parser::Frame
 Parser::parse_list(const Token& token)
 {
-    List result;
-
-    TokenType close_bracket = TokenType::Undefined;
+    Frame frame{ FrameType::List, TokenType::Undefined, ast::List() };
+    frame.list.set_position(token.position);
 
     // Round
     if (token.type == TokenType::SymbolBracketRoundLeft) {
-        close_bracket = TokenType::SymbolBracketRoundRight;
+        frame.close_bracket = TokenType::SymbolBracketRoundRight;
     }
     // Square
     else if (token.type == TokenType::SymbolBracketSquareLeft) {
-        close_bracket = TokenType::SymbolBracketSquareRight;
+        frame.close_bracket = TokenType::SymbolBracketSquareRight;
     }
     // Curly
     else if (token.type == TokenType::SymbolBracketCurlyLeft) {
-        close_bracket = TokenType::SymbolBracketCurlyRight;
-        result.is_textlist = true;
+        frame.close_bracket = TokenType::SymbolBracketCurlyRight;
+        frame.list.is_textlist = true;
     }
 
-    while (_scanner) {
-        auto t = _scanner.get();
-        if (t.type == TokenType::Whitespace || t.type == TokenType::Comment) {
-            continue;
-        } else if (t.type == close_bracket) {
-            return result;
-        } else {
-            result.push_back(parse_expression(t));
-        }
-    }
-    throw UnclosedList(stringify(close_bracket));
+    return frame;
 }
 
 ast::Expression
 Parser::parse_text_element(const Token& token)
 {
     if (token.type == TokenType::TextContent) {
-        return Atom(AtomType::String, token.content);
+        Atom result(AtomType::String, token.content);
+        result.set_position(token.position);
+        return result;
     }
 
     if (token.type == TokenType::TextEmptyLine) {
         List result;
+        result.set_position(token.position);
         result.push_back(_atom_helper.create_by_type(AtomType::Quote));
         result.push_back(_atom_helper.create_emptyline_symbol());
         return result;
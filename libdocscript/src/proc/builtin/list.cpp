@@ -1,12 +1,308 @@
 #include "libdocscript/runtime/list.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/proc/builtin.h"
+#include "libdocscript/proc/utility.h"
 #include "libdocscript/runtime/procedure.h"
 #include "libdocscript/runtime/value.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace libdocscript::proc {
+
+namespace {
+// The result of procedure that is used as a value, only for-each takes the
+// unspecific result like the definition
+Value
+value_of(Value result)
+{
+    if (result.type() == DataType::Kind::Unspecific)
+        throw DefinitionException();
+    return result;
+}
+
+// The lists shorter than the thresholds are sorted in the calling thread,
+// calling a procedure costs much more than comparing two numbers.
+constexpr std::size_t parallel_threshold = 1 << 15;
+constexpr std::size_t procedure_parallel_threshold = 1 << 11;
+
+template<typename Key>
+struct SortItem
+{
+    Key key;
+    Value* value;
+};
+
+template<typename Key>
+using sort_items = std::vector<SortItem<Key>>;
+
+// Run the tasks 0 to count - 1, the task 0 runs in the calling thread. The
+// error of the first failed task is raised after all of them finished.
+template<typename Task>
+void
+run_tasks(std::size_t count, Task task)
+{
+    std::vector<std::exception_ptr> errors(count);
+    auto run = [&](std::size_t index) {
+        try {
+            task(index);
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < count; ++i) {
+        try {
+            workers.emplace_back(run, i);
+        } catch (const std::system_error&) {
+            run(i);
+        }
+    }
+    run(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+// Merge the runs of doubling width. std::merge takes the elements of the
+// left run first when they are equal, and it never reads out of the runs
+// even if the procedure gives an inconsistent ordering.
+template<typename Key, typename Less>
+void
+merge_sort(typename sort_items<Key>::iterator beg,
+           typename sort_items<Key>::iterator end,
+           Less& less)
+{
+    const std::size_t size = end - beg;
+    sort_items<Key> buffer(beg, end);
+    auto from = buffer.begin();
+    auto to = beg;
+    for (std::size_t width = 1; width < size; width *= 2) {
+        std::swap(from, to);
+        for (std::size_t lo = 0; lo < size; lo += 2 * width) {
+            auto mid = std::min(lo + width, size);
+            auto hi = std::min(lo + 2 * width, size);
+            std::merge(from + lo,
+                       from + mid,
+                       from + mid,
+                       from + hi,
+                       to + lo,
+                       std::ref(less));
+        }
+    }
+    if (to != beg)
+        std::copy(to, to + size, beg);
+}
+
+// Sort the runs of items in several threads then merge the neighbour runs
+// level by level. sort_run(beg, end) sorts one run, make_less() gives the
+// ordering used by one thread.
+template<typename Key, typename SortRun, typename MakeLess>
+void
+sort_in_parallel(sort_items<Key>& items,
+                 std::size_t threshold,
+                 SortRun sort_run,
+                 MakeLess make_less)
+{
+    const auto size = items.size();
+    std::size_t runs = std::thread::hardware_concurrency();
+    runs = std::min(runs, size / threshold);
+    if (runs < 2) {
+        sort_run(items.begin(), items.end());
+        return;
+    }
+
+    std::vector<std::size_t> bounds(runs + 1);
+    for (std::size_t i = 0; i <= runs; ++i) {
+        bounds[i] = size * i / runs;
+    }
+    run_tasks(runs, [&](std::size_t index) {
+        sort_run(items.begin() + bounds[index],
+                 items.begin() + bounds[index + 1]);
+    });
+
+    sort_items<Key> buffer(size);
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        run_tasks((runs + 2 * width - 1) / (2 * width), [&](std::size_t index) {
+            auto lo = bounds[index * 2 * width];
+            auto mid = bounds[std::min(index * 2 * width + width, runs)];
+            auto hi = bounds[std::min(index * 2 * width + 2 * width, runs)];
+            auto less = make_less();
+            std::merge(items.begin() + lo,
+                       items.begin() + mid,
+                       items.begin() + mid,
+                       items.begin() + hi,
+                       buffer.begin() + lo,
+                       std::ref(less));
+        });
+        items.swap(buffer);
+    }
+}
+
+// NaN is ordered after the other numbers, so that the ordering is strict
+// weak ordering which std::sort requires
+bool
+decimal_less(Number::dec_type lhs, Number::dec_type rhs)
+{
+    if (std::isnan(rhs))
+        return !std::isnan(lhs);
+    return lhs < rhs;
+}
+
+bool
+number_less(const Number& lhs, const Number& rhs)
+{
+    if (lhs.type() == Number::Integer && rhs.type() == Number::Integer)
+        return lhs.integer() < rhs.integer();
+    return decimal_less(lhs.decimal(), rhs.decimal());
+}
+
+// Sort the packed numbers without unpacking the list, the result is packed
+// too
+template<typename T, typename Less>
+List
+sort_packed(std::vector<T> nums, Less less, bool stable)
+{
+    if (stable)
+        std::stable_sort(nums.begin(), nums.end(), less);
+    else
+        std::sort(nums.begin(), nums.end(), less);
+    return List(std::move(nums));
+}
+
+template<typename Key>
+List
+sorted_list(const sort_items<Key>& items)
+{
+    List result;
+    result.reserve(items.size());
+    for (const auto& item : items) {
+        result.push_back(std::move(*item.value));
+    }
+    return result;
+}
+
+template<typename Key, typename Less>
+List
+sort_by_key(sort_items<Key>& items, Less less, bool stable)
+{
+    using iterator = typename sort_items<Key>::iterator;
+    sort_in_parallel<Key>(
+      items,
+      parallel_threshold,
+      [&](iterator beg, iterator end) {
+          if (stable)
+              std::stable_sort(beg, end, less);
+          else
+              std::sort(beg, end, less);
+      },
+      [&]() { return less; });
+    return sorted_list(items);
+}
+
+// Sort the list by the natural ordering of numbers or strings, or by the
+// procedure which returns #t if its first argument is ordered before the
+// second one
+List
+sort_list(args_list args, Environment& env, bool stable)
+{
+    auto& list = args.front();
+
+    const auto& packed = list.c_cast<List>();
+    if (args.size() == 1 && packed.storage() == List::Integers)
+        return sort_packed(packed.integers(), std::less<>(), stable);
+    if (args.size() == 1 && packed.storage() == List::Decimals)
+        return sort_packed(packed.decimals(), decimal_less, stable);
+
+    auto& elems = list.cast<List>().raw();
+    if (elems.empty())
+        return List();
+
+    if (args.size() == 2) {
+        const auto& func = args.back().c_cast<Procedure>();
+        auto make_less = [&]() {
+            return [&func, local = env.derive()](
+                     const SortItem<Value*>& lhs,
+                     const SortItem<Value*>& rhs) mutable {
+                return static_cast<bool>(
+                  value_of(Utility::invoke(func, local, *lhs.key, *rhs.key)));
+            };
+        };
+
+        sort_items<Value*> items;
+        items.reserve(elems.size());
+        for (auto& elem : elems) {
+            items.push_back({ &elem, &elem });
+        }
+        using iterator = sort_items<Value*>::iterator;
+        sort_in_parallel<Value*>(
+          items,
+          procedure_parallel_threshold,
+          [&](iterator beg, iterator end) {
+              auto less = make_less();
+              merge_sort<Value*>(beg, end, less);
+          },
+          make_less);
+        return sorted_list(items);
+    }
+
+    auto kind = elems.front().type();
+    if (kind != DataType::Kind::Number && kind != DataType::Kind::String)
+        throw UnexceptType(DataType::to_string(DataType::Kind::Number),
+                           DataType::to_string(kind));
+    for (const auto& elem : elems) {
+        if (elem.type() != kind)
+            throw UnexceptType(DataType::to_string(kind),
+                               DataType::to_string(elem.type()));
+    }
+
+    if (kind == DataType::Kind::Number) {
+        sort_items<const Number*> items;
+        items.reserve(elems.size());
+        for (auto& elem : elems) {
+            items.push_back({ &elem.c_cast<Number>(), &elem });
+        }
+        return sort_by_key(
+          items,
+          [](const SortItem<const Number*>& lhs,
+             const SortItem<const Number*>& rhs) {
+              return number_less(*lhs.key, *rhs.key);
+          },
+          stable);
+    }
+
+    sort_items<std::string_view> items;
+    items.reserve(elems.size());
+    for (auto& elem : elems) {
+        items.push_back({ elem.c_cast<String>().view(), &elem });
+    }
+    return sort_by_key(
+      items,
+      [](const SortItem<std::string_view>& lhs,
+         const SortItem<std::string_view>& rhs) {
+          return lhs.key < rhs.key;
+      },
+      stable);
+}
+}
+
 Value
 list_is(args_list args, Environment& env)
 {
@@ -141,7 +437,7 @@ list_first(args_list args, Environment& env)
     if (first.size() == 0)
         return Nil();
     else
-        return *(first.cbegin());
+        return first.at(0);
 }
 
 Value
@@ -158,66 +454,50 @@ list_last(args_list args, Environment& env)
     if (first.size() == 0)
         return Nil();
     else
-        return *(first.cend() - 1);
+        return first.at(first.size() - 1);
 }
 
 Value
 list_car(args_list args, Environment& env)
 {
-    if (args.size() != 1)
-        throw UnexceptNumberOfArgument(1, args.size());
-
-    if (!list_is(args, env) && args.front().c_cast<List>().size() != 0)
+    // The number and the type of argument are checked by the signature
+    auto& list = args.front().c_cast<List>();
+    if (list.size() == 0)
         throw UnexceptType(DataType::to_string(DataType::Kind::List),
-                           DataType::to_string(args.front().type()) +
-                             ", or an empty list");
+                           "an empty list");
 
-    auto& list = args.front().c_cast<List>();
-    return *(list.cbegin());
+    return list.at(0);
 }
 
 Value
 list_cdr(args_list args, Environment& env)
 {
-    if (args.size() != 1)
-        throw UnexceptNumberOfArgument(1, args.size());
-
-    if (!list_is(args, env) && args.front().c_cast<List>().size() != 0)
+    // The number and the type of argument are checked by the signature
+    auto& list = args.front().c_cast<List>();
+    if (list.size() == 0)
         throw UnexceptType(DataType::to_string(DataType::Kind::List),
-                           DataType::to_string(args.front().type()) +
-                             ", or an empty list");
+                           "an empty list");
 
-    auto& list = args.front().c_cast<List>();
     if(list.size() == 1) {
         return List();
     } else {
-        return List(list.cbegin() + 1, list.cend());
+        return list.sublist(1);
     }
 }
 
 Value
 list_nth(args_list args, Environment& env)
 {
-    if (args.size() != 2)
-        throw UnexceptNumberOfArgument(1, args.size());
-
+    // The number and the type of arguments are checked by the signature
     auto& first = args.front();
     auto& second = args.back();
 
-    if (first.type() != DataType::Kind::List)
-        throw UnexceptType(DataType::to_string(DataType::Kind::List),
-                           DataType::to_string(first.type()));
-
-    if (second.type() != DataType::Kind::Number)
-        throw UnexceptType(DataType::to_string(DataType::Kind::Number),
-                           DataType::to_string(second.type()));
-
     auto i = second.c_cast<Number>().integer();
 
     if (i < 0 || i >= first.c_cast<List>().size())
         throw RuntimeError("out of list range");
 
-    return first.c_cast<List>().craw()[i];
+    return first.c_cast<List>().at(i);
 }
 
 Value
@@ -246,8 +526,9 @@ list_reverse(args_list args, Environment& env)
 
     auto& list = args.front().c_cast<List>();
     List result;
-    for (auto beg = list.craw().crbegin(); beg != list.craw().crend(); ++beg) {
-        result.push_back(*beg);
+    result.reserve(list.size());
+    for (auto i = list.size(); i != 0; --i) {
+        result.push_back(list.at(i - 1));
     }
     return result;
 }
@@ -266,9 +547,9 @@ list_concat(args_list args, Environment& env)
 
     auto result = args.begin()->c_cast<List>();
     for (auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        auto list = beg->c_cast<List>();
-        for (const auto& val : list.craw()) {
-            result.push_back(val);
+        const auto& list = beg->c_cast<List>();
+        for (List::size_type i = 0; i != list.size(); ++i) {
+            result.push_back(list.at(i));
         }
     }
 
@@ -306,4 +587,156 @@ list_empty_is(args_list args, Environment& env)
 
     return Boolean(args.front().c_cast<List>().size() == 0);
 }
+
+Value
+list_map(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& proc = args.front();
+    auto& list = args.back();
+
+    const auto& func = proc.c_cast<Procedure>();
+    const auto& elems = list.c_cast<List>().craw();
+    List result;
+    result.reserve(elems.size());
+    for (const auto& elem : elems) {
+        result.push_back(value_of(Utility::invoke(func, env, elem)));
+    }
+    return result;
+}
+
+Value
+list_pmap(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& proc = args.front();
+    auto& list = args.back();
+
+    const auto& func = proc.c_cast<Procedure>();
+    const auto& elems = list.c_cast<List>().craw();
+    const auto size = elems.size();
+
+    // The elements are taken by chunks in order, so every element before
+    // the first failed one has been evaluated, and the error is the same
+    // one as map raises.
+    constexpr std::size_t chunk_size = 16;
+    std::atomic<std::size_t> next{ 0 };
+    std::atomic<std::size_t> failed{ size };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    std::vector<std::optional<Value>> results(size);
+
+    auto work = [&]() {
+        // The environment of caller is only read while the workers run
+        Environment local = env.derive();
+        for (;;) {
+            auto beg = next.fetch_add(chunk_size);
+            if (beg >= size)
+                return;
+            auto end = std::min(beg + chunk_size, size);
+            for (auto i = beg; i != end; ++i) {
+                if (i > failed.load())
+                    return;
+                try {
+                    results[i].emplace(
+                      value_of(Utility::invoke(func, local, elems[i])));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (i < failed.load()) {
+                        failed.store(i);
+                        error = std::current_exception();
+                    }
+                    return;
+                }
+            }
+        }
+    };
+
+    std::size_t thread_count = std::thread::hardware_concurrency();
+    thread_count = std::min(thread_count, (size + chunk_size - 1) / chunk_size);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        try {
+            workers.emplace_back(work);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    List result;
+    result.reserve(size);
+    for (auto& value : results) {
+        result.push_back(std::move(*value));
+    }
+    return result;
+}
+
+Value
+list_filter(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& proc = args.front();
+    auto& list = args.back();
+
+    const auto& func = proc.c_cast<Procedure>();
+    List result;
+    for (const auto& elem : list.c_cast<List>().craw()) {
+        if (static_cast<bool>(value_of(Utility::invoke(func, env, elem))))
+            result.push_back(elem);
+    }
+    return result;
+}
+
+Value
+list_fold(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& proc = args[0];
+    auto& list = args[2];
+
+    const auto& func = proc.c_cast<Procedure>();
+    Value result = args[1];
+    for (const auto& elem : list.c_cast<List>().craw()) {
+        result = value_of(Utility::invoke(func, env, result, elem));
+    }
+    return result;
+}
+
+Value
+list_for_each(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& proc = args.front();
+    auto& list = args.back();
+
+    const auto& func = proc.c_cast<Procedure>();
+    // The results are dropped, so the body may be a definition or return
+    // unspecific
+    for (const auto& elem : list.c_cast<List>().craw()) {
+        Utility::invoke(func, env, elem);
+    }
+    return Unspecific();
+}
+
+Value
+list_sort(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    return sort_list(args, env, false);
+}
+
+Value
+list_stable_sort(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    return sort_list(args, env, true);
+}
+
 }
\ No newline at end of file
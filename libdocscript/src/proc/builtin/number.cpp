@@ -1,15 +1,246 @@
 #include "libdocscript/exception.h"
 #include "libdocscript/proc/builtin.h"
 #include "libdocscript/proc/utility.h"
+#include "libdocscript/runtime/list.h"
 #include "libdocscript/runtime/procedure.h"
 #include "libdocscript/runtime/value.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <numeric>
+#include <string>
+#include <vector>
 
 namespace libdocscript::proc {
 
+namespace {
+using int_type = Number::int_type;
+using dec_type = Number::dec_type;
+
+// The digits after the decimal point formatted by number->string at most
+constexpr int_type max_precision = 1000;
+
+// The integer operations give false rather than overflow, then the rest of
+// calculation is done in decimal.
+
+bool
+add_integer(int_type lhs, int_type rhs, int_type& result)
+{
+    if ((rhs > 0 && lhs > std::numeric_limits<int_type>::max() - rhs) ||
+        (rhs < 0 && lhs < std::numeric_limits<int_type>::min() - rhs))
+        return false;
+    result = lhs + rhs;
+    return true;
+}
+
+bool
+minus_integer(int_type lhs, int_type rhs, int_type& result)
+{
+    if ((rhs < 0 && lhs > std::numeric_limits<int_type>::max() + rhs) ||
+        (rhs > 0 && lhs < std::numeric_limits<int_type>::min() + rhs))
+        return false;
+    result = lhs - rhs;
+    return true;
+}
+
+bool
+mul_integer(int_type lhs, int_type rhs, int_type& result)
+{
+    constexpr auto max = std::numeric_limits<int_type>::max();
+    constexpr auto min = std::numeric_limits<int_type>::min();
+    if (lhs > 0 ? (rhs > 0 ? lhs > max / rhs : rhs < min / lhs)
+                : (rhs > 0 ? lhs < min / rhs : lhs != 0 && rhs < max / lhs))
+        return false;
+    result = lhs * rhs;
+    return true;
+}
+
+// Only the exact division stays integer
+bool
+div_integer(int_type lhs, int_type rhs, int_type& result)
+{
+    if (rhs == 0 || (rhs == -1 && lhs == std::numeric_limits<int_type>::min()) ||
+        lhs % rhs != 0)
+        return false;
+    result = lhs / rhs;
+    return true;
+}
+
+// Fold the non-empty range of numbers from left to right
+template<typename Iterator, typename IntegerOp, typename DecimalOp>
+Number
+fold_numbers(Iterator beg,
+             Iterator end,
+             IntegerOp integer_op,
+             DecimalOp decimal_op)
+{
+    const auto& first = beg->template c_cast<Number>();
+    ++beg;
+
+    dec_type decimal = first.decimal();
+    if (first.type() == Number::Integer) {
+        int_type integer = first.integer();
+        for (; beg != end; ++beg) {
+            const auto& num = beg->template c_cast<Number>();
+            if (num.type() != Number::Integer ||
+                !integer_op(integer, num.integer(), integer))
+                break;
+        }
+        if (beg == end)
+            return Number(integer);
+        decimal = static_cast<dec_type>(integer);
+    }
+
+    for (; beg != end; ++beg) {
+        decimal = decimal_op(decimal, beg->template c_cast<Number>().decimal());
+    }
+    return Number(decimal);
+}
+
+// The first one of the non-empty range of numbers that no other number
+// is ordered before it by compare
+template<typename Iterator, typename Compare>
+Number
+select_number(Iterator beg, Iterator end, Compare compare)
+{
+    const Number* result = &beg->template c_cast<Number>();
+    for (++beg; beg != end; ++beg) {
+        const auto& num = beg->template c_cast<Number>();
+        bool before =
+          num.type() == Number::Integer && result->type() == Number::Integer
+            ? compare(num.integer(), result->integer())
+            : compare(num.decimal(), result->decimal());
+        if (before)
+            result = &num;
+    }
+    return *result;
+}
+
+// Fold the non-empty packed integers as fold_numbers does
+template<typename IntegerOp, typename DecimalOp>
+Number
+fold_integers(const std::vector<int_type>& nums,
+              IntegerOp integer_op,
+              DecimalOp decimal_op)
+{
+    auto beg = nums.begin() + 1, end = nums.end();
+    int_type integer = nums.front();
+    for (; beg != end; ++beg) {
+        if (!integer_op(integer, *beg, integer))
+            break;
+    }
+    if (beg == end)
+        return Number(integer);
+
+    auto decimal = static_cast<dec_type>(integer);
+    for (; beg != end; ++beg) {
+        decimal = decimal_op(decimal, static_cast<dec_type>(*beg));
+    }
+    return Number(decimal);
+}
+
+// The sum of the non-empty packed integers. The integers which can't
+// overflow are added without the check, so the loops are vectorized.
+Number
+sum_integers(const std::vector<int_type>& nums)
+{
+    int_type min = 0, max = 0;
+    for (auto num : nums) {
+        min = std::min(min, num);
+        max = std::max(max, num);
+    }
+    auto limit = std::numeric_limits<int_type>::max() /
+                 static_cast<int_type>(nums.size());
+    if (max <= limit && min >= -limit)
+        return Number(std::accumulate(nums.begin(), nums.end(), int_type(0)));
+    return fold_integers(nums, add_integer, std::plus<dec_type>());
+}
+
+// Fold the packed list of numbers, or the elements of the unpacked one
+template<typename IntegerOp, typename DecimalOp>
+Number
+fold_list(const List& list, IntegerOp integer_op, DecimalOp decimal_op)
+{
+    switch (list.storage()) {
+        case List::Integers:
+            return fold_integers(list.integers(), integer_op, decimal_op);
+        case List::Decimals: {
+            const auto& nums = list.decimals();
+            return Number(std::accumulate(
+              nums.begin() + 1, nums.end(), nums.front(), decimal_op));
+        }
+        default:
+            return fold_numbers(
+              list.cbegin(), list.cend(), integer_op, decimal_op);
+    }
+}
+
+// The first one of the non-empty list of numbers that no other number is
+// ordered before it by compare
+template<typename Compare>
+Number
+select_list(const List& list, Compare compare)
+{
+    // std::min_element keeps the first one as select_number does
+    switch (list.storage()) {
+        case List::Integers: {
+            const auto& nums = list.integers();
+            return Number(*std::min_element(nums.begin(), nums.end(), compare));
+        }
+        case List::Decimals: {
+            const auto& nums = list.decimals();
+            return Number(*std::min_element(nums.begin(), nums.end(), compare));
+        }
+        default:
+            return select_number(list.cbegin(), list.cend(), compare);
+    }
+}
+
+// The list that all elements are numbers
+const List&
+number_list(const Value& val)
+{
+    const auto& list = val.c_cast<List>();
+    // The packed list is known to be of numbers
+    if (list.storage() != List::Generic)
+        return list;
+    for (const auto& elem : list.craw()) {
+        if (elem.type() != DataType::Kind::Number)
+            throw UnexceptType(DataType::to_string(DataType::Kind::Number),
+                               DataType::to_string(elem.type()));
+    }
+    return list;
+}
+
+const List&
+nonempty_number_list(const Value& val)
+{
+    const auto& list = number_list(val);
+    if (list.size() == 0)
+        throw UnexceptType(DataType::to_string(DataType::Kind::List),
+                           "an empty list");
+    return list;
+}
+
+template<typename Compare>
+Boolean
+compare_numbers(args_list args, Compare compare)
+{
+    for (auto beg = args.begin() + 1; beg != args.end(); ++beg) {
+        const auto& lhs = (beg - 1)->c_cast<Number>();
+        const auto& rhs = beg->c_cast<Number>();
+        bool result =
+          lhs.type() == Number::Integer && rhs.type() == Number::Integer
+            ? compare(lhs.integer(), rhs.integer())
+            : compare(lhs.decimal(), rhs.decimal());
+        if (!result)
+            return Boolean(false);
+    }
+    return Boolean(true);
+}
+}
+
 Value
 number_is(args_list args, Environment& env)
 {
@@ -43,14 +274,52 @@ number_eq(args_list args, Environment& env)
 Value
 number_to_string(args_list args, Environment& env)
 {
-    if (args.size() != 1)
-        throw UnexceptNumberOfArgument(1, args.size());
+    // The number and the type of arguments are checked by the signature
+    const auto& num = args[0].c_cast<Number>();
 
-    if (args.front().type() != DataType::Kind::Number)
-        throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                           DataType::to_string(args.front().type()));
+    int radix = 10;
+    if (args.size() >= 2) {
+        auto value = args[1].c_cast<Number>().integer();
+        if (value < 2 || value > 36)
+            throw RuntimeError("the radix is not in the range 2 - 36");
+        radix = static_cast<int>(value);
+    }
+
+    int precision = -1;
+    if (args.size() == 3) {
+        auto value = args[2].c_cast<Number>().integer();
+        if (value < 0 || value > max_precision)
+            throw RuntimeError("the precision is not in the range 0 - " +
+                               std::to_string(max_precision));
+        precision = static_cast<int>(value);
+    }
 
-    return String(args.front());
+    if (radix != 10 && (num.type() == Number::Decimal || precision >= 0))
+        throw RuntimeError("only the integer could be formatted in the "
+                           "radix other than 10");
+
+    return String(num.to_string(radix, precision));
+}
+
+Value
+string_to_number(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& first = args.front();
+
+    int radix = 10;
+    if (args.size() == 2) {
+        auto value = args.back().c_cast<Number>().integer();
+        if (value < 2 || value > 36)
+            throw RuntimeError("the radix is not in the range 2 - 36");
+        radix = static_cast<int>(value);
+    }
+
+    // The malformed text is not an error, so that the fields of data could
+    // be checked by nil?
+    if (auto num = Number::parse(first.c_cast<String>().view(), radix))
+        return *num;
+    return Nil();
 }
 
 Value
@@ -162,73 +431,49 @@ number_odd_is(args_list args, Environment& env)
 Value
 number_add(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(
-      args, [](const Number& v, Utility::number_list list) -> Number {
-          if (list.size() == 0) {
-              if (v.type() == Number::Integer)
-                  return Number(std::abs(v.integer()));
-              else
-                  return Number(std::abs(v.decimal()));
-          }
-
-          long double result = v.decimal();
-          for (const auto& num : list) {
-              result += num.decimal();
-          }
-          return Number(result);
-      });
+    // The number and the type of arguments are checked by the signature
+    if (args.size() == 1) {
+        const auto& v = args.front().c_cast<Number>();
+        if (v.type() == Number::Integer)
+            return Number(std::abs(v.integer()));
+        else
+            return Number(std::abs(v.decimal()));
+    }
+    return fold_numbers(
+      args.begin(), args.end(), add_integer, std::plus<dec_type>());
 }
 
 Value
 number_minus(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(
-      args, [](const Number& v, Utility::number_list list) -> Number {
-          if (list.size() == 0 && v.decimal() > 0) {
-              if (v.type() == Number::Integer)
-                  return Number(v.integer() * -1);
-              else
-                  return Number(v.decimal() * -1);
-          }
-
-          long double result = v.decimal();
-          for (const auto& num : list) {
-              result -= num.decimal();
-          }
-          return Number(result);
-      });
+    // The number and the type of arguments are checked by the signature
+    if (args.size() == 1) {
+        const auto& v = args.front().c_cast<Number>();
+        if (v.decimal() <= 0)
+            return v;
+        if (v.type() == Number::Integer)
+            return Number(v.integer() * -1);
+        else
+            return Number(v.decimal() * -1);
+    }
+    return fold_numbers(
+      args.begin(), args.end(), minus_integer, std::minus<dec_type>());
 }
 
 Value
 number_mul(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(args,
-                                       [](const Number& v1,
-                                          const Number& v2,
-                                          Utility::number_list list) -> Number {
-                                           long double result =
-                                             v1.decimal() * v2.decimal();
-                                           for (const auto& num : list) {
-                                               result *= num.decimal();
-                                           }
-                                           return Number(result);
-                                       });
+    // The number and the type of arguments are checked by the signature
+    return fold_numbers(
+      args.begin(), args.end(), mul_integer, std::multiplies<dec_type>());
 }
 
 Value
 number_div(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(args,
-                                       [](const Number& v1,
-                                          const Number& v2,
-                                          Utility::number_list list) -> Number {
-                                           long double result =
-                                             v1.decimal() * v2.decimal();
-                                           for (const auto& num : list) {
-                                               result /= num.decimal();
-                                           }
-                                           return Number(result);
-                                       });
+    // The number and the type of arguments are checked by the signature
+    return fold_numbers(
+      args.begin(), args.end(), div_integer, std::divides<dec_type>());
 }
 
 Value
@@ -386,101 +631,36 @@ number_integer_div(args_list args, Environment& env)
 Value
 number_great_than(args_list args, Environment& env)
 {
-    if(args.size() < 2)
-        throw UnexceptNumberOfArgument(2, args.size(), true);
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::Number)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    long double last = args.front().c_cast<Number>().decimal();
-    for(auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if(last <= beg->c_cast<Number>().decimal())
-            return Boolean(false);
-        last = beg->c_cast<Number>().decimal();
-    }
-    return Boolean(true);
+    // The number and the type of arguments are checked by the signature
+    return compare_numbers(args, std::greater<>());
 }
 
 Value
 number_less_than(args_list args, Environment& env)
 {
-    if(args.size() < 2)
-        throw UnexceptNumberOfArgument(2, args.size(), true);
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::Number)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    long double last = args.front().c_cast<Number>().decimal();
-    for(auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if(last >= beg->c_cast<Number>().decimal())
-            return Boolean(false);
-        last = beg->c_cast<Number>().decimal();
-    }
-    return Boolean(true);
+    // The number and the type of arguments are checked by the signature
+    return compare_numbers(args, std::less<>());
 }
 
 Value
 number_equal(args_list args, Environment& env)
 {
-    if(args.size() < 2)
-        throw UnexceptNumberOfArgument(2, args.size(), true);
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::Number)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    long double last = args.front().c_cast<Number>().decimal();
-    for(auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if(last != beg->c_cast<Number>().decimal())
-            return Boolean(false);
-        last = beg->c_cast<Number>().decimal();
-    }
-    return Boolean(true);
+    // The number and the type of arguments are checked by the signature
+    return compare_numbers(args, std::equal_to<>());
 }
 
 Value
 number_great_equal(args_list args, Environment& env)
 {
-    if(args.size() < 2)
-        throw UnexceptNumberOfArgument(2, args.size(), true);
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::Number)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    long double last = args.front().c_cast<Number>().decimal();
-    for(auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if(last < beg->c_cast<Number>().decimal())
-            return Boolean(false);
-        last = beg->c_cast<Number>().decimal();
-    }
-    return Boolean(true);
+    // The number and the type of arguments are checked by the signature
+    return compare_numbers(args, std::greater_equal<>());
 }
 
 Value
 number_less_equal(args_list args, Environment& env)
 {
-    if(args.size() < 2)
-        throw UnexceptNumberOfArgument(2, args.size(), true);
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::Number)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    long double last = args.front().c_cast<Number>().decimal();
-    for(auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if(last > beg->c_cast<Number>().decimal())
-            return Boolean(false);
-        last = beg->c_cast<Number>().decimal();
-    }
-    return Boolean(true);
+    // The number and the type of arguments are checked by the signature
+    return compare_numbers(args, std::less_equal<>());
 }
 
 Value
@@ -550,38 +730,57 @@ number_log(args_list args, Environment& env)
 Value
 number_max(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(
-      args, [](Utility::number_list list) -> Number {
-          if (list.size() == 0) {
-              return Number(std::numeric_limits<Number::dec_type>().max());
-          } else if (list.size() == 1) {
-              return list.front();
-          } else {
-              return *(std::max_element(list.begin(),
-                                        list.end(),
-                                        [](const Number& v1, const Number& v2) {
-                                            return v1.decimal() > v2.decimal();
-                                        }));
-          }
-      });
+    // The type of arguments are checked by the signature
+    if (args.size() == 0)
+        return Number(std::numeric_limits<Number::dec_type>().max());
+    return select_number(args.begin(), args.end(), std::greater<>());
 }
+
 Value
 number_min(args_list args, Environment& env)
 {
-    return Utility::number_func_helper(
-      args, [](Utility::number_list list) -> Number {
-          if (list.size() == 0) {
-              return Number(std::numeric_limits<Number::dec_type>().min());
-          } else if (list.size() == 1) {
-              return list.front();
-          } else {
-              return *(std::min_element(list.begin(),
-                                        list.end(),
-                                        [](const Number& v1, const Number& v2) {
-                                            return v1.decimal() < v2.decimal();
-                                        }));
-          }
-      });
+    // The type of arguments are checked by the signature
+    if (args.size() == 0)
+        return Number(std::numeric_limits<Number::dec_type>().min());
+    return select_number(args.begin(), args.end(), std::less<>());
+}
+
+Value
+number_sum(args_list args, Environment& env)
+{
+    // The number and the type of argument are checked by the signature
+    const auto& list = number_list(args.front());
+    if (list.size() == 0)
+        return Number(0);
+    if (list.storage() == List::Integers)
+        return sum_integers(list.integers());
+    return fold_list(list, add_integer, std::plus<dec_type>());
+}
+
+Value
+number_product(args_list args, Environment& env)
+{
+    // The number and the type of argument are checked by the signature
+    const auto& list = number_list(args.front());
+    if (list.size() == 0)
+        return Number(1);
+    return fold_list(list, mul_integer, std::multiplies<dec_type>());
+}
+
+Value
+number_list_max(args_list args, Environment& env)
+{
+    // The number and the type of argument are checked by the signature
+    const auto& list = nonempty_number_list(args.front());
+    return select_list(list, std::greater<>());
+}
+
+Value
+number_list_min(args_list args, Environment& env)
+{
+    // The number and the type of argument are checked by the signature
+    const auto& list = nonempty_number_list(args.front());
+    return select_list(list, std::less<>());
 }
 
 Value
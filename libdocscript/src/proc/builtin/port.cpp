@@ -0,0 +1,44 @@
+#include "libdocscript/runtime/string_port.h"
+#include "libdocscript/exception.h"
+#include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/procedure.h"
+#include "libdocscript/runtime/value.h"
+
+namespace libdocscript::proc {
+Value
+port_is(args_list args, Environment& env)
+{
+    if (args.size() != 1)
+        throw UnexceptNumberOfArgument(1, args.size());
+
+    return Boolean(args.front().type() == DataType::Kind::Port);
+}
+
+Value
+port_open_output_string(args_list, Environment& env)
+{
+    // The number of arguments are checked by the signature
+    return StringPort();
+}
+
+Value
+port_write_string(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& str = args.front();
+    auto& port = args.back();
+
+    // The copies of port share the content, and the port is returned so
+    // that it could be written in the body of lambda and by fold
+    port.cast<StringPort>().write(str.c_cast<String>().view());
+    return port;
+}
+
+Value
+port_get_output_string(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    return String(args.front().c_cast<StringPort>().str());
+}
+
+}
\ No newline at end of file
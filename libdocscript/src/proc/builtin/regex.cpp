@@ -0,0 +1,207 @@
+#include "libdocscript/utility/regex.h"
+#include "libdocscript/exception.h"
+#include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/list.h"
+#include "libdocscript/runtime/procedure.h"
+#include "libdocscript/runtime/value.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace libdocscript::proc {
+
+namespace {
+// The compiled patterns used recently are kept, so the pattern in the body
+// of a loop is compiled once. The cache is locked for pmap.
+class RegexCache
+{
+  public:
+    static constexpr std::size_t capacity = 64;
+
+    std::shared_ptr<const Regex> get(std::string_view pattern)
+    {
+        std::string key(pattern);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto iter = _index.find(key);
+            if (iter != _index.end()) {
+                _entries.splice(_entries.begin(), _entries, iter->second);
+                return iter->second->second;
+            }
+        }
+
+        // The pattern is compiled without the lock, an invalid one throws
+        // before it is added
+        auto regex = std::make_shared<const Regex>(pattern);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = _index.find(key);
+        if (iter != _index.end())
+            return iter->second->second;
+
+        _entries.emplace_front(key, regex);
+        _index.emplace(std::move(key), _entries.begin());
+        if (_entries.size() > capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+        return regex;
+    }
+
+  private:
+    using entry_type = std::pair<std::string, std::shared_ptr<const Regex>>;
+
+    std::mutex _mutex;
+    // The most recently used one is at the front
+    std::list<entry_type> _entries;
+    std::unordered_map<std::string, std::list<entry_type>::iterator> _index;
+};
+
+std::shared_ptr<const Regex>
+compile(const Value& pattern)
+{
+    static RegexCache cache;
+    return cache.get(pattern.c_cast<String>().view());
+}
+
+// The list of the whole match and the groups, they are the slices of the
+// string, and the group which doesn't participate is nil
+Value
+groups_list(const String& str, const Regex::Match& match)
+{
+    List result;
+    result.reserve(match.size() / 2);
+    for (std::size_t i = 0; i < match.size(); i += 2) {
+        if (match[i] == Regex::npos || match[i + 1] == Regex::npos)
+            result.push_back(Nil());
+        else
+            result.push_back(str.substr(match[i], match[i + 1] - match[i]));
+    }
+    return result;
+}
+
+// Append the replacement with $0 - $9 substituted by the groups, and $$ by
+// the `$'
+void
+append_replacement(std::string& result,
+                   std::string_view text,
+                   std::string_view replacement,
+                   const Regex::Match& match)
+{
+    for (std::size_t i = 0; i < replacement.size(); ++i) {
+        auto ch = replacement[i];
+        if (ch != '$' || i + 1 == replacement.size()) {
+            result.push_back(ch);
+            continue;
+        }
+
+        auto next = replacement[i + 1];
+        if (next == '$') {
+            result.push_back('$');
+            ++i;
+        } else if (next >= '0' && next <= '9') {
+            std::size_t group = next - '0';
+            if (group * 2 >= match.size())
+                throw RuntimeError("no group $" + std::string(1, next) +
+                                   " in the regular expression");
+            auto begin = match[group * 2], end = match[group * 2 + 1];
+            if (begin != Regex::npos && end != Regex::npos)
+                result.append(text, begin, end - begin);
+            ++i;
+        } else {
+            result.push_back(ch);
+        }
+    }
+}
+}
+
+Value
+regex_match(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args[0].c_cast<String>();
+    auto regex = compile(args[1]);
+
+    Regex::Match match;
+    if (!regex->match(str.view(), match))
+        return Boolean(false);
+    return groups_list(str, match);
+}
+
+Value
+regex_search(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args[0].c_cast<String>();
+    auto regex = compile(args[1]);
+
+    Regex::Match match;
+    if (!regex->search(str.view(), 0, match))
+        return Boolean(false);
+    return groups_list(str, match);
+}
+
+Value
+regex_replace(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args[0].c_cast<String>();
+    auto regex = compile(args[1]);
+    auto replacement = args[2].c_cast<String>().view();
+    auto text = str.view();
+
+    Regex::Match match;
+    if (!regex->search(text, 0, match))
+        return str;
+
+    std::string result;
+    result.reserve(text.size());
+    std::size_t pos = 0;
+    do {
+        result.append(text, pos, match[0] - pos);
+        append_replacement(result, text, replacement, match);
+        pos = match[1];
+
+        // The empty match is followed by the next character, so that the
+        // same position isn't matched again
+        if (match[0] == match[1]) {
+            if (pos == text.size())
+                break;
+            result.push_back(text[pos++]);
+        }
+    } while (regex->search(text, pos, match));
+
+    result.append(text, pos);
+    return String(std::move(result));
+}
+
+Value
+regex_split(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args[0].c_cast<String>();
+    auto regex = compile(args[1]);
+    auto text = str.view();
+
+    // The parts are the slices of the string, the empty matches don't split
+    // the string
+    List result;
+    Regex::Match match;
+    std::size_t begin = 0, pos = 0;
+    while (pos <= text.size() && regex->search(text, pos, match)) {
+        if (match[0] == match[1]) {
+            pos = match[1] + 1;
+            continue;
+        }
+        result.push_back(str.substr(begin, match[0] - begin));
+        begin = pos = match[1];
+    }
+    result.push_back(str.substr(begin));
+    return result;
+}
+
+}
\ No newline at end of file
@@ -3,10 +3,170 @@
 #include "libdocscript/proc/utility.h"
 #include "libdocscript/runtime/list.h"
 #include "libdocscript/runtime/procedure.h"
+#include "libdocscript/runtime/string_port.h"
 #include "libdocscript/runtime/value.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <initializer_list>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace libdocscript::proc {
+
+namespace {
+// The pattern not shorter than it is searched by Horspool's algorithm which
+// skips the text by the table of the pattern, the shorter one is searched by
+// std::string_view::find which looks for the first character by memchr.
+constexpr std::string_view::size_type horspool_threshold = 8;
+
+class Finder
+{
+  public:
+    using size_type = std::string_view::size_type;
+
+    Finder(std::string_view pattern)
+      : _pattern(pattern)
+    {
+        if (pattern.empty())
+            throw RuntimeError("the pattern to search is empty");
+
+        if (pattern.size() >= horspool_threshold)
+            _searcher.emplace(pattern.begin(), pattern.end());
+    }
+
+    size_type size() const { return _pattern.size(); }
+
+    // The position of the first match from pos, or npos if none
+    size_type find(std::string_view text, size_type pos) const
+    {
+        if (!_searcher)
+            return text.find(_pattern, pos);
+
+        if (pos > text.size())
+            return text.npos;
+        auto iter = std::search(text.begin() + pos, text.end(), *_searcher);
+        return iter == text.end() ? text.npos : iter - text.begin();
+    }
+
+  private:
+    using searcher_type =
+      std::boyer_moore_horspool_searcher<std::string_view::const_iterator>;
+
+    std::string_view _pattern;
+    std::optional<searcher_type> _searcher;
+};
+
+// The trimmed part of a long string is a slice of it
+String
+trimmed(const String& str, std::string_view (*trim)(std::string_view))
+{
+    auto text = str.view();
+    auto part = trim(text);
+    return str.substr(part.data() - text.data(), part.size());
+}
+
+// The replacement of every byte, the byte which has an empty one is kept
+using EscapeTable = std::array<std::string_view, 256>;
+
+EscapeTable
+make_escape_table(
+  std::initializer_list<std::pair<unsigned char, std::string_view>> entries)
+{
+    EscapeTable table{};
+    for (const auto& [ch, replacement] : entries) {
+        table[ch] = replacement;
+    }
+    return table;
+}
+
+const EscapeTable html_escape_table = make_escape_table({
+  { '&', "&amp;" },
+  { '<', "&lt;" },
+  { '>', "&gt;" },
+  { '"', "&quot;" },
+  { '\'', "&#39;" },
+});
+
+const EscapeTable xml_escape_table = make_escape_table({
+  { '&', "&amp;" },
+  { '<', "&lt;" },
+  { '>', "&gt;" },
+  { '"', "&quot;" },
+  { '\'', "&apos;" },
+});
+
+const EscapeTable tex_escape_table = make_escape_table({
+  { '\\', "\\textbackslash{}" },
+  { '{', "\\{" },
+  { '}', "\\}" },
+  { '$', "\\$" },
+  { '&', "\\&" },
+  { '#', "\\#" },
+  { '%', "\\%" },
+  { '_', "\\_" },
+  { '^', "\\textasciicircum{}" },
+  { '~', "\\textasciitilde{}" },
+});
+
+// Pass the runs of kept bytes and the replacements to output in order, the
+// runs are passed as a whole instead of byte by byte
+template<typename Output>
+void
+escape_each(std::string_view text, const EscapeTable& table, Output output)
+{
+    std::string_view::size_type begin = 0;
+    for (std::string_view::size_type i = 0; i < text.size(); ++i) {
+        auto replacement = table[static_cast<unsigned char>(text[i])];
+        if (replacement.empty())
+            continue;
+        if (i != begin)
+            output(text.substr(begin, i - begin));
+        output(replacement);
+        begin = i + 1;
+    }
+    if (begin != text.size())
+        output(text.substr(begin));
+}
+
+// Escape the string, or write the escaped string into the port if it is
+// given and return the port
+Value
+escape(args_list args, const EscapeTable& table)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args.front().c_cast<String>();
+    auto text = str.view();
+
+    if (args.size() == 2) {
+        auto& port = args.back();
+        auto& output = port.cast<StringPort>();
+        escape_each(text, table, [&](std::string_view part) {
+            output.write(part);
+        });
+        return port;
+    }
+
+    // The size of result is counted first, so that it is allocated once,
+    // and the string without any byte to escape is returned as is
+    auto size = text.size();
+    for (unsigned char ch : text) {
+        if (!table[ch].empty())
+            size += table[ch].size() - 1;
+    }
+    if (size == text.size())
+        return str;
+
+    std::string result;
+    result.reserve(size);
+    escape_each(text, table, [&](std::string_view part) {
+        result.append(part);
+    });
+    return String(std::move(result));
+}
+}
 Value
 string_is(args_list args, Environment& env)
 {
@@ -20,18 +180,11 @@ string_is(args_list args, Environment& env)
 Value
 string_eq(args_list args, Environment& env)
 {
-    if (args.size() < 1)
-        throw UnexceptNumberOfArgument(1, args.size(), true);
-
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::String)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    auto& first = args.front();
+    // The number and the type of arguments are checked by the signature
+    // The sizes are compared before the content which is compared by memcmp
+    auto first = args.front().c_cast<String>().view();
     for (auto beg = args.begin() + 1; beg != args.end(); ++beg) {
-        if (first != *beg)
+        if (first != beg->c_cast<String>().view())
             return Boolean(false);
     }
     return Boolean(true);
@@ -104,8 +257,8 @@ string_gt_is(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(second.type()));
 
-    return Boolean(first.c_cast<String>().const_value() >
-                   second.c_cast<String>().const_value());
+    return Boolean(first.c_cast<String>().view() >
+                   second.c_cast<String>().view());
 }
 
 Value
@@ -125,8 +278,8 @@ string_lt_is(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(second.type()));
 
-    return Boolean(first.c_cast<String>().const_value() >
-                   second.c_cast<String>().const_value());
+    return Boolean(first.c_cast<String>().view() >
+                   second.c_cast<String>().view());
 }
 
 Value
@@ -146,8 +299,8 @@ string_length(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(second.type()));
 
-    return Boolean(first.c_cast<String>().const_value() <
-                   second.c_cast<String>().const_value());
+    return Boolean(first.c_cast<String>().view() <
+                   second.c_cast<String>().view());
 }
 
 Value
@@ -170,20 +323,13 @@ string_append(args_list args, Environment& env)
 Value
 string_concat(args_list args, Environment& env)
 {
-    if (args.size() < 1)
-        throw UnexceptNumberOfArgument(1, args.size());
-
-    for (const auto& val : args) {
-        if (val.type() != DataType::Kind::String)
-            throw UnexceptType(DataType::to_string(DataType::Kind::String),
-                               DataType::to_string(val.type()));
-    }
-
-    std::string content;
-    for (auto beg = args.begin(); beg != args.end(); ++beg) {
-        content.append(static_cast<std::string>(*beg));
+    // The number and the type of arguments are checked by the signature
+    // The long strings are joined as ropes without copying their content
+    String result(std::move(args.front().cast<String>()));
+    for (auto beg = args.begin() + 1; beg != args.end(); ++beg) {
+        result.append(beg->c_cast<String>());
     }
-    return String(content);
+    return result;
 }
 
 Value
@@ -196,7 +342,7 @@ string_ltrim(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(args.front().type()));
 
-    return String(Utility::ltrim(args.front().c_cast<String>()));
+    return trimmed(args.front().c_cast<String>(), Utility::ltrim);
 }
 
 Value
@@ -209,7 +355,7 @@ string_rtrim(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(args.front().type()));
 
-    return String(Utility::rtrim(args.front().c_cast<String>()));
+    return trimmed(args.front().c_cast<String>(), Utility::rtrim);
 }
 
 Value
@@ -222,7 +368,7 @@ string_trim(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(args.front().type()));
 
-    return String(Utility::trim(args.front().c_cast<String>()));
+    return trimmed(args.front().c_cast<String>(), Utility::trim);
 }
 
 Value
@@ -242,15 +388,90 @@ string_split(args_list args, Environment& env)
         throw UnexceptType(DataType::to_string(DataType::Kind::String),
                            DataType::to_string(second.type()));
 
-    auto splited =
-      Utility::split(first.c_cast<String>(), second.c_cast<String>());
+    const auto& str = first.c_cast<String>();
+    auto text = str.view();
+    auto delimiter = second.c_cast<String>().view();
+    if (delimiter.empty())
+        throw RuntimeError("the delimiter of string-split is empty");
+
+    // The parts of a long string are the slices of it
     List result;
-    for (const auto& str : splited) {
-        result.push_back(String(str));
+    for (auto part : Utility::split(text, delimiter)) {
+        result.push_back(str.substr(part.data() - text.data(), part.size()));
     }
     return result;
 }
 
+Value
+string_index(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& first = args[0];
+    auto& second = args[1];
+
+    Number::int_type start = 0;
+    if (args.size() == 3) {
+        start = args[2].c_cast<Number>().integer();
+        if (start < 0)
+            throw RuntimeError("except a number that not less than 0");
+    }
+
+    Finder finder(second.c_cast<String>().view());
+    auto i = finder.find(first.c_cast<String>().view(), start);
+    if (i == std::string_view::npos)
+        return Boolean(false);
+    return Number(static_cast<Number::int_type>(i));
+}
+
+Value
+string_contains_is(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    Finder finder(args.back().c_cast<String>().view());
+    auto text = args.front().c_cast<String>().view();
+    return Boolean(finder.find(text, 0) != std::string_view::npos);
+}
+
+Value
+string_count(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    Finder finder(args.back().c_cast<String>().view());
+    auto text = args.front().c_cast<String>().view();
+
+    Number::int_type count = 0;
+    for (auto i = finder.find(text, 0); i != std::string_view::npos;
+         i = finder.find(text, i + finder.size())) {
+        ++count;
+    }
+    return Number(count);
+}
+
+Value
+string_replace(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& str = args[0].c_cast<String>();
+    Finder finder(args[1].c_cast<String>().view());
+    auto replacement = args[2].c_cast<String>().view();
+    auto text = str.view();
+
+    auto i = finder.find(text, 0);
+    if (i == std::string_view::npos)
+        return str;
+
+    std::string result;
+    result.reserve(text.size());
+    std::string_view::size_type pos = 0;
+    for (; i != std::string_view::npos; i = finder.find(text, pos)) {
+        result.append(text, pos, i - pos);
+        result.append(replacement);
+        pos = i + finder.size();
+    }
+    result.append(text, pos);
+    return String(std::move(result));
+}
+
 Value
 string_substring(args_list args, Environment& env)
 {
@@ -269,11 +490,11 @@ string_substring(args_list args, Environment& env)
 
         auto& str = first.c_cast<String>();
         auto& i = second.c_cast<Number>();
-        if (i.integer() >= str.const_value().size() || i.integer() < 0)
+        if (i.integer() >= str.size() || i.integer() < 0)
             throw RuntimeError("except a number that smaller than the size of "
                                "the string, and not less than 0");
 
-        return String(str.const_value().substr(i.integer()));
+        return str.substr(i.integer());
     }
     // Length
     else if (args.size() == 3) {
@@ -295,19 +516,36 @@ string_substring(args_list args, Environment& env)
 
         auto& str = first.c_cast<String>();
         auto& i = second.c_cast<Number>();
-        if (i.integer() >= str.const_value().size() || i.integer() < 0)
+        if (i.integer() >= str.size() || i.integer() < 0)
             throw RuntimeError("except a number that smaller than the size of "
                                "the string, and not less than 0");
 
-        auto& l = second.c_cast<Number>();
-        if (l.integer() <= 0 ||
-            l.integer() > (str.const_value().size() - i.integer()))
-            return String(str.const_value().substr(i.integer()));
+        auto& l = third.c_cast<Number>();
+        if (l.integer() <= 0 || l.integer() > (str.size() - i.integer()))
+            return str.substr(i.integer());
         else
-            return String(str.const_value().substr(i.integer(), l.integer()));
+            return str.substr(i.integer(), l.integer());
     } else {
         throw UnexceptNumberOfArgument(3, args.size());
     }
 }
 
+Value
+string_html_escape(args_list args, Environment& env)
+{
+    return escape(args, html_escape_table);
+}
+
+Value
+string_xml_escape(args_list args, Environment& env)
+{
+    return escape(args, xml_escape_table);
+}
+
+Value
+string_tex_escape(args_list args, Environment& env)
+{
+    return escape(args, tex_escape_table);
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "libdocscript/runtime/table.h"
+#include "libdocscript/exception.h"
+#include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/list.h"
+#include "libdocscript/runtime/procedure.h"
+#include "libdocscript/runtime/value.h"
+#include <string>
+#include <utility>
+
+namespace libdocscript::proc {
+
+namespace {
+Table&
+table_argument(Value& val)
+{
+    // The copies of table share the entries, so updating the argument
+    // updates the table of caller
+    return val.cast<Table>();
+}
+}
+
+Value
+table_is(args_list args, Environment& env)
+{
+    if (args.size() != 1)
+        throw UnexceptNumberOfArgument(1, args.size());
+
+    return Boolean(args.front().type() == DataType::Kind::Table);
+}
+
+Value
+table_make_table(args_list, Environment& env)
+{
+    // The number of arguments are checked by the signature
+    return Table();
+}
+
+Value
+table_ref(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& table = table_argument(args[0]);
+    const auto& key = args[1];
+
+    if (auto val = table.find(key))
+        return *val;
+
+    if (args.size() == 3)
+        return args[2];
+
+    throw RuntimeError("no entry of the key in table: " +
+                       static_cast<std::string>(key));
+}
+
+Value
+table_set(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    // The table is returned, so that it could be updated in the body of
+    // lambda and by fold
+    auto& table = table_argument(args[0]);
+    table.set(args[1], args[2]);
+    return args[0];
+}
+
+Value
+table_has_is(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& table = table_argument(args[0]);
+    return Boolean(table.find(args[1]) != nullptr);
+}
+
+Value
+table_keys(args_list args, Environment& env)
+{
+    // The number of arguments are checked by the signature
+    const auto& table = table_argument(args.front());
+
+    List result;
+    result.reserve(table.size());
+    for (const auto& entry : table.craw()) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+Value
+table_to_list(args_list args, Environment& env)
+{
+    // The number of arguments are checked by the signature
+    const auto& table = table_argument(args.front());
+
+    List result;
+    result.reserve(table.size());
+    for (const auto& entry : table.craw()) {
+        List pair;
+        pair.push_back(entry.first);
+        pair.push_back(entry.second);
+        result.push_back(std::move(pair));
+    }
+    return result;
+}
+
+}
\ No newline at end of file
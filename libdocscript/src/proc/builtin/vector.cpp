@@ -0,0 +1,119 @@
+#include "libdocscript/runtime/vector.h"
+#include "libdocscript/exception.h"
+#include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/list.h"
+#include "libdocscript/runtime/procedure.h"
+#include "libdocscript/runtime/value.h"
+#include <utility>
+
+namespace libdocscript::proc {
+
+namespace {
+Vector&
+vector_argument(Value& val)
+{
+    // The copies of vector share the elements, so updating the argument
+    // updates the vector of caller
+    return val.cast<Vector>();
+}
+
+Vector::raw_type::size_type
+vector_index(const Vector& vec, const Value& val)
+{
+    auto i = val.c_cast<Number>().integer();
+    if (i < 0 || static_cast<Vector::raw_type::size_type>(i) >= vec.size())
+        throw RuntimeError("out of vector range");
+
+    return static_cast<Vector::raw_type::size_type>(i);
+}
+}
+
+Value
+vector_is(args_list args, Environment& env)
+{
+    if (args.size() != 1)
+        throw UnexceptNumberOfArgument(1, args.size());
+
+    return Boolean(args.front().type() == DataType::Kind::Vector);
+}
+
+Value
+vector_to_list(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    return List(args.front().c_cast<Vector>().craw());
+}
+
+Value
+list_to_vector(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& list = args.front().c_cast<List>();
+    return Vector(list.cbegin(), list.cend());
+}
+
+Value
+vector_make_vector(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& first = args.front();
+    auto& second = args.back();
+
+    auto size = second.c_cast<Number>().integer();
+    if (size < 0)
+        throw RuntimeError("negative size of vector");
+
+    Vector result;
+    result.raw().assign(static_cast<Vector::raw_type::size_type>(size), first);
+    return result;
+}
+
+Value
+vector_(args_list args, Environment& env)
+{
+    Vector result;
+    result.raw().reserve(args.size());
+    for (const auto& elem : args) {
+        result.raw().push_back(elem);
+    }
+    return result;
+}
+
+Value
+vector_length(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& vec = args.front().c_cast<Vector>();
+    return Number(static_cast<Number::int_type>(vec.size()));
+}
+
+Value
+vector_ref(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    const auto& vec = vector_argument(args[0]);
+    return vec.craw()[vector_index(vec, args[1])];
+}
+
+// The vector is returned by vector-set! and vector-push!, so that it could
+// be updated in the body of lambda and by fold
+
+Value
+vector_set(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& vec = vector_argument(args[0]);
+    vec.raw()[vector_index(vec, args[1])] = std::move(args[2]);
+    return args[0];
+}
+
+Value
+vector_push(args_list args, Environment& env)
+{
+    // The number and the type of arguments are checked by the signature
+    auto& vec = vector_argument(args[0]);
+    vec.raw().push_back(std::move(args[1]));
+    return args[0];
+}
+
+}
\ No newline at end of file
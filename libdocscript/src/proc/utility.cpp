@@ -1,17 +1,19 @@
 #include "libdocscript/proc/utility.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/arguments.h"
 #include "libdocscript/runtime/datatype.h"
 #include "libdocscript/runtime/value.h"
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace libdocscript::proc {
 std::vector<Number>
-Utility::convert_to_number_list(std::vector<Value>::const_iterator beg,
-                                std::vector<Value>::const_iterator end)
+Utility::convert_to_number_list(Arguments::const_iterator beg,
+                                Arguments::const_iterator end)
 {
     std::vector<Number> result;
     while (beg != end) {
@@ -99,42 +101,77 @@ Utility::number_func_helper(args_list args, func_num_multiple func)
     return func(convert_to_number_list(args.begin(), args.end()));
 }
 
-std::string
-Utility::ltrim(const std::string& str)
+Value
+Utility::invoke(const Procedure& proc, Environment& env, const Value& arg)
 {
-    auto iter = std::find_if(
-      str.begin(), str.end(), [](const char ch) { return !std::isspace(ch); });
-    return iter != str.end() ? std::string(iter, str.end()) : str;
+    ArgumentStack::Frame args(ArgumentStack::current(), 1);
+    args.push_back(Value(arg));
+
+    return proc.invoke(args.arguments(), env);
 }
 
-std::string
-Utility::rtrim(const std::string& str)
+Value
+Utility::invoke(const Procedure& proc,
+                Environment& env,
+                const Value& arg1,
+                const Value& arg2)
 {
-    auto iter = std::find_if(str.rbegin(), str.rend(), [](const char ch) {
-        return !std::isspace(ch);
-    });
+    ArgumentStack::Frame args(ArgumentStack::current(), 2);
+    args.push_back(Value(arg1));
+    args.push_back(Value(arg2));
+
+    return proc.invoke(args.arguments(), env);
+}
+
+namespace {
+// The character is converted to unsigned char as std::isspace requires
+bool
+is_space(char ch)
+{
+    return std::isspace(static_cast<unsigned char>(ch));
+}
+}
 
-    return iter != str.rend() ? std::string(str.begin(), iter.base()) : str;
+std::string_view
+Utility::ltrim(std::string_view str)
+{
+    std::string_view::size_type i = 0;
+    while (i != str.size() && is_space(str[i])) {
+        ++i;
+    }
+    return str.substr(i);
+}
+
+std::string_view
+Utility::rtrim(std::string_view str)
+{
+    auto size = str.size();
+    while (size != 0 && is_space(str[size - 1])) {
+        --size;
+    }
+    return str.substr(0, size);
 }
 
-std::string
-Utility::trim(const std::string& str)
+std::string_view
+Utility::trim(std::string_view str)
 {
     return ltrim(rtrim(str));
 }
 
-std::vector<std::string>
-Utility::split(const std::string& str, const std::string &ch)
+std::vector<std::string_view>
+Utility::split(std::string_view str, std::string_view d)
 {
-    std::vector<std::string> result;
-    auto sstr = str;
-    decltype(sstr.size()) i = str.npos;
-    while((i = sstr.find(ch)) != sstr.npos) {
-        auto part = std::string(sstr.begin(), sstr.begin() + i);
-        result.push_back(part);
-        sstr = sstr.substr(i + ch.size());
+    if (d.empty())
+        return { str };
+
+    // std::string_view::find looks for the first character of d by memchr
+    std::vector<std::string_view> result;
+    std::string_view::size_type pos = 0;
+    for (auto i = str.find(d); i != str.npos; i = str.find(d, pos)) {
+        result.push_back(str.substr(pos, i - pos));
+        pos = i + d.size();
     }
-    result.push_back(sstr);
+    result.push_back(str.substr(pos));
     return result;
 }
 
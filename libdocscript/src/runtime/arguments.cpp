@@ -0,0 +1,151 @@
+#include "libdocscript/runtime/arguments.h"
+#include "libdocscript/runtime/value.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace libdocscript::runtime {
+
+// +--------------------+
+//      Constructor
+// +--------------------+
+
+Arguments::Arguments()
+  : _first(nullptr)
+  , _size(0)
+{}
+
+Arguments::Arguments(Value* first, size_type size)
+  : _first(first)
+  , _size(size)
+{}
+
+Arguments::Arguments(std::vector<Value>& values)
+  : _first(values.data())
+  , _size(values.size())
+{}
+
+ArgumentStack::Frame::Frame(ArgumentStack& stack, size_type capacity)
+  : _stack(stack)
+  , _prev_chunk(stack._active)
+  , _chunk(stack.take(capacity))
+  , _start(stack._chunks[_chunk].top)
+  , _size(0)
+{
+    stack._chunks[_chunk].top += capacity;
+}
+
+// +--------------------+
+//      Destructor
+// +--------------------+
+
+ArgumentStack::Frame::~Frame()
+{
+    for (size_type i = 0; i != _size; ++i) {
+        std::destroy_at(slot(i));
+    }
+    _stack._chunks[_chunk].top = _start;
+    _stack._active = _prev_chunk;
+}
+
+// +--------------------+
+//    Public Functions
+// +--------------------+
+
+Arguments::size_type
+Arguments::size() const
+{
+    return _size;
+}
+
+bool
+Arguments::empty() const
+{
+    return _size == 0;
+}
+
+Arguments::iterator
+Arguments::begin() const
+{
+    return _first;
+}
+
+Arguments::iterator
+Arguments::end() const
+{
+    return _first + _size;
+}
+
+Value&
+Arguments::front() const
+{
+    return *_first;
+}
+
+Value&
+Arguments::back() const
+{
+    return *(_first + _size - 1);
+}
+
+Value&
+Arguments::operator[](size_type index) const
+{
+    return *(_first + index);
+}
+
+void
+ArgumentStack::Frame::push_back(Value&& val)
+{
+    new (&_stack._chunks[_chunk].slots[_start + _size]) Value(std::move(val));
+    ++_size;
+}
+
+Arguments
+ArgumentStack::Frame::arguments() const
+{
+    return Arguments(_size ? slot(0) : nullptr, _size);
+}
+
+ArgumentStack&
+ArgumentStack::current()
+{
+    static thread_local ArgumentStack stack;
+    return stack;
+}
+
+// +--------------------+
+//    Private Functions
+// +--------------------+
+
+Value*
+ArgumentStack::Frame::slot(size_type index) const
+{
+    return std::launder(reinterpret_cast<Value*>(
+      &_stack._chunks[_chunk].slots[_start + index]));
+}
+
+ArgumentStack::size_type
+ArgumentStack::take(size_type count)
+{
+    if (!_chunks.empty()) {
+        auto& chunk = _chunks[_active];
+        if (chunk.capacity - chunk.top >= count)
+            return _active;
+        ++_active;
+    }
+
+    // The chunks after the active one are always empty
+    if (_active == _chunks.size()) {
+        _chunks.push_back(Chunk{ nullptr, 0, 0 });
+    }
+    auto& chunk = _chunks[_active];
+    if (chunk.capacity < count) {
+        chunk.capacity = std::max(count, chunk_capacity);
+        chunk.slots = std::make_unique<slot_type[]>(chunk.capacity);
+    }
+    return _active;
+}
+}
\ No newline at end of file
@@ -24,6 +24,12 @@ DataType::rawptr_clone() const
     return new DataType(*this);
 }
 
+DataType*
+DataType::rawptr_clone_to(void*) const
+{
+    return nullptr;
+}
+
 // +--------------------+
 //    Type Conversion
 // +--------------------+
@@ -53,6 +59,8 @@ DataType::to_string(DataType::Kind k)
             return "error";
         case Kind::Symbol:
             return "symbol";
+        case Kind::Boolean:
+            return "boolean";
         case Kind::Number:
             return "number";
         case Kind::String:
@@ -61,6 +69,12 @@ DataType::to_string(DataType::Kind k)
             return "list";
         case Kind::Procedure:
             return "procedure";
+        case Kind::Table:
+            return "table";
+        case Kind::Vector:
+            return "vector";
+        case Kind::Port:
+            return "port";
         default:
             throw InternalUnimplementException(
               "DataType::to_string(DataType::Kind)");
@@ -1,4 +1,5 @@
 #include "libdocscript/runtime/datatype.h"
+#include <new>
 
 namespace libdocscript::runtime {
 
@@ -45,4 +46,10 @@ Boolean::rawptr_clone() const
     return new Boolean(*this);
 }
 
+DataType*
+Boolean::rawptr_clone_to(void* buffer) const
+{
+    return new (buffer) Boolean(*this);
+}
+
 }
\ No newline at end of file
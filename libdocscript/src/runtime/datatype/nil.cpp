@@ -1,4 +1,5 @@
 #include "libdocscript/runtime/datatype.h"
+#include <new>
 #include <string>
 
 namespace libdocscript::runtime {
@@ -13,6 +14,12 @@ Nil::rawptr_clone() const
     return new Nil(*this);
 }
 
+DataType*
+Nil::rawptr_clone_to(void* buffer) const
+{
+    return new (buffer) Nil(*this);
+}
+
 // +--------------------+
 //     Type Conversion
 // +--------------------+
@@ -1,7 +1,13 @@
 #include "libdocscript/runtime/datatype.h"
+#include <cctype>
+#include <charconv>
+#include <cmath>
 #include <limits>
+#include <new>
+#include <optional>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <system_error>
 
 namespace libdocscript::runtime {
 
@@ -77,6 +83,94 @@ Number::type() const
     return _type;
 }
 
+std::string
+Number::to_string(int radix, int precision) const
+{
+    if (_type == Integer && precision < 0) {
+        // Enough for the 64 bits in radix 2 and the sign
+        char buffer[std::numeric_limits<int_type>::digits + 2];
+        auto result = std::to_chars(
+          buffer, buffer + sizeof(buffer), _value.integer, radix);
+        return std::string(buffer, result.ptr);
+    }
+
+    // NaN is never equal to itself, its sign is read by std::signbit
+    auto value = decimal();
+    if (std::isnan(value))
+        return std::signbit(value) ? "-nan" : "+nan";
+    else if (std::isinf(value))
+        return std::signbit(value) ? "-inf" : "+inf";
+
+    // The shortest form is in fixed notation unless the value is too small
+    // or too large to be read in it, as the plain std::to_chars gives 1e+05
+    // for 100000
+    auto magnitude = std::fabs(value);
+    auto shortest = value == 0 || (magnitude >= 1e-7L && magnitude < 1e21L)
+                      ? std::chars_format::fixed
+                      : std::chars_format::general;
+
+    // The shortest form is short, but the fixed form of a large value has
+    // all of its digits, so the buffer grows until it fits
+    std::string buffer(64, '\0');
+    while (true) {
+        auto first = buffer.data(), last = buffer.data() + buffer.size();
+        auto result =
+          precision < 0
+            ? std::to_chars(first, last, value, shortest)
+            : std::to_chars(
+                first, last, value, std::chars_format::fixed, precision);
+        if (result.ec == std::errc()) {
+            buffer.resize(result.ptr - first);
+            return buffer;
+        }
+        buffer.resize(buffer.size() * 4);
+    }
+}
+
+std::optional<Number>
+Number::parse(std::string_view text, int radix)
+{
+    using limits = std::numeric_limits<dec_type>;
+    if (text == "inf" || text == "+inf")
+        return Number(limits::infinity());
+    if (text == "-inf")
+        return Number(-1 * limits::infinity());
+    if (text == "nan" || text == "+nan")
+        return Number(limits::signaling_NaN());
+    if (text == "-nan")
+        return Number(-limits::signaling_NaN());
+
+    // std::from_chars takes the minus sign only
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+        if (!text.empty() && text.front() == '-')
+            return std::nullopt;
+    }
+
+    auto digits = text.substr(!text.empty() && text.front() == '-' ? 1 : 0);
+    if (digits.empty())
+        return std::nullopt;
+
+    auto first = text.data(), last = text.data() + text.size();
+    int_type integer;
+    auto result = std::from_chars(first, last, integer, radix);
+    if (result.ec == std::errc() && result.ptr == last)
+        return Number(integer);
+
+    // The words like infinity are taken by std::from_chars, but they aren't
+    // the numbers of the language
+    if (radix != 10 ||
+        (!std::isdigit(static_cast<unsigned char>(digits.front())) &&
+         digits.front() != '.'))
+        return std::nullopt;
+
+    dec_type decimal;
+    result = std::from_chars(first, last, decimal);
+    if (result.ec == std::errc() && result.ptr == last)
+        return Number(decimal);
+    return std::nullopt;
+}
+
 // +--------------------+
 //    Private Functions
 // +--------------------+
@@ -87,6 +181,12 @@ Number::rawptr_clone() const
     return new Number(*this);
 }
 
+DataType*
+Number::rawptr_clone_to(void* buffer) const
+{
+    return new (buffer) Number(*this);
+}
+
 // +--------------------+
 //     Type Conversion
 // +--------------------+
@@ -107,26 +207,9 @@ Number::operator bool() const
     }
 }
 
-Number::operator std::string() const 
+Number::operator std::string() const
 {
-    std::ostringstream oss;
-    if (_type == Integer) {
-        oss << _value.integer;
-        return oss.str();
-    } else {
-        auto value = _value.decimal;
-        if(value == std::numeric_limits<dec_type>().signaling_NaN())
-            oss << "+nan";
-        else if (value == std::numeric_limits<dec_type>().signaling_NaN() * -1)
-            oss << "-nan";
-        else if (value == std::numeric_limits<dec_type>().infinity())
-            oss << "+inf";
-        else if (value == std::numeric_limits<dec_type>().infinity() * -1)
-            oss << "-inf";
-        else
-            oss << value;
-        return oss.str();
-    }
+    return to_string();
 }
 
 Number::operator libdocscript::runtime::Number::int_type() const
@@ -1,17 +1,215 @@
 #include "libdocscript/runtime/datatype.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace libdocscript::runtime {
 
+// +--------------------+
+//        Rope
+// +--------------------+
+
+///
+/// \brief The node of rope, a leaf refers a part of the shared text, and the
+///        other node is the concatenation of its children. The heights of
+///        two children differ by one at most, so that the rope is balanced.
+///
+struct String::Node
+{
+    std::shared_ptr<const std::string> text;
+    size_type offset = 0;
+    node_ptr left;
+    node_ptr right;
+    size_type length = 0;
+    int height = 0;
+
+    // The content of the concatenation is built once it is required
+    mutable std::once_flag flat_once;
+    mutable std::string flat;
+
+    bool is_leaf() const { return text != nullptr; }
+
+    const std::string& content() const
+    {
+        if (is_leaf() && offset == 0 && length == text->size())
+            return *text;
+
+        std::call_once(flat_once, [this]() {
+            flat.reserve(length);
+            append_to(flat);
+        });
+        return flat;
+    }
+
+    void append_to(std::string& out) const
+    {
+        if (is_leaf()) {
+            out.append(*text, offset, length);
+        } else {
+            left->append_to(out);
+            right->append_to(out);
+        }
+    }
+
+    static node_ptr make_leaf(std::shared_ptr<const std::string> text,
+                              size_type offset,
+                              size_type length)
+    {
+        auto node = std::make_shared<Node>();
+        node->text = std::move(text);
+        node->offset = offset;
+        node->length = length;
+        return node;
+    }
+
+    // The short leaves are merged, so that appending short strings one by
+    // one does not make a leaf for each of them
+    static node_ptr make_concat(node_ptr lhs, node_ptr rhs)
+    {
+        if (lhs->is_leaf() && rhs->is_leaf() &&
+            lhs->length + rhs->length <= rope_threshold) {
+            std::string merged;
+            merged.reserve(lhs->length + rhs->length);
+            lhs->append_to(merged);
+            rhs->append_to(merged);
+            auto length = merged.size();
+            return make_leaf(
+              std::make_shared<const std::string>(std::move(merged)),
+              0,
+              length);
+        }
+
+        auto node = std::make_shared<Node>();
+        node->length = lhs->length + rhs->length;
+        node->height = std::max(lhs->height, rhs->height) + 1;
+        node->left = std::move(lhs);
+        node->right = std::move(rhs);
+        return node;
+    }
+
+    static node_ptr rotate_left(const node_ptr& node)
+    {
+        if (node->is_leaf() || node->right->is_leaf())
+            return node;
+        return make_concat(make_concat(node->left, node->right->left),
+                           node->right->right);
+    }
+
+    static node_ptr rotate_right(const node_ptr& node)
+    {
+        if (node->is_leaf() || node->left->is_leaf())
+            return node;
+        return make_concat(node->left->left,
+                           make_concat(node->left->right, node->right));
+    }
+
+    // Join as the AVL tree does, lhs is higher than rhs by two at least
+    static node_ptr join_right(const node_ptr& lhs, const node_ptr& rhs)
+    {
+        const auto& left = lhs->left;
+        const auto& middle = lhs->right;
+        if (middle->height <= rhs->height + 1) {
+            auto joined = make_concat(middle, rhs);
+            if (joined->height <= left->height + 1)
+                return make_concat(left, joined);
+            return rotate_left(make_concat(left, rotate_right(joined)));
+        }
+
+        auto joined = join_right(middle, rhs);
+        if (joined->height <= left->height + 1)
+            return make_concat(left, joined);
+        return rotate_left(make_concat(left, joined));
+    }
+
+    // rhs is higher than lhs by two at least
+    static node_ptr join_left(const node_ptr& lhs, const node_ptr& rhs)
+    {
+        const auto& middle = rhs->left;
+        const auto& right = rhs->right;
+        if (middle->height <= lhs->height + 1) {
+            auto joined = make_concat(lhs, middle);
+            if (joined->height <= right->height + 1)
+                return make_concat(joined, right);
+            return rotate_right(make_concat(rotate_left(joined), right));
+        }
+
+        auto joined = join_left(lhs, middle);
+        if (joined->height <= right->height + 1)
+            return make_concat(joined, right);
+        return rotate_right(make_concat(joined, right));
+    }
+
+    static node_ptr join(const node_ptr& lhs, const node_ptr& rhs)
+    {
+        if (!lhs || lhs->length == 0)
+            return rhs;
+        if (!rhs || rhs->length == 0)
+            return lhs;
+
+        if (lhs->height > rhs->height + 1)
+            return join_right(lhs, rhs);
+        if (rhs->height > lhs->height + 1)
+            return join_left(lhs, rhs);
+        return make_concat(lhs, rhs);
+    }
+
+    // The part of node, pos + len must not be greater than its length
+    static node_ptr sub(const node_ptr& node, size_type pos, size_type len)
+    {
+        if (len == 0)
+            return nullptr;
+        if (pos == 0 && len == node->length)
+            return node;
+        if (node->is_leaf())
+            return make_leaf(node->text, node->offset + pos, len);
+
+        auto left_length = node->left->length;
+        if (pos + len <= left_length)
+            return sub(node->left, pos, len);
+        if (pos >= left_length)
+            return sub(node->right, pos - left_length, len);
+        return join(sub(node->left, pos, left_length - pos),
+                    sub(node->right, 0, pos + len - left_length));
+    }
+};
+
 // +--------------------+
 //      Constructor
 // +--------------------+
 
 String::String(const std::string& str)
-  : DataType(DataType::Kind::String)
-  , _value(str)
+  : String(std::string(str))
 {}
 
+String::String(std::string&& str)
+  : DataType(DataType::Kind::String)
+{
+    if (str.size() < rope_threshold) {
+        _value = std::move(str);
+    } else {
+        auto length = str.size();
+        _rope = Node::make_leaf(
+          std::make_shared<const std::string>(std::move(str)), 0, length);
+    }
+}
+
+String::String(node_ptr rope)
+  : DataType(DataType::Kind::String)
+{
+    if (!rope)
+        return;
+
+    if (rope->is_leaf() || rope->length >= rope_threshold) {
+        _rope = std::move(rope);
+    } else {
+        rope->append_to(_value);
+    }
+}
+
 // +--------------------+
 //    Public Functions
 // +--------------------+
@@ -19,22 +217,86 @@ String::String(const std::string& str)
 std::string&
 String::value()
 {
+    if (_rope) {
+        _value = std::string(view());
+        _rope.reset();
+    }
     return _value;
 }
 
 const std::string&
 String::const_value() const
 {
-    return _value;
+    return _rope ? _rope->content() : _value;
+}
+
+std::string_view
+String::view() const
+{
+    if (!_rope)
+        return _value;
+    if (_rope->is_leaf())
+        return std::string_view(_rope->text->data() + _rope->offset,
+                                _rope->length);
+    return _rope->content();
+}
+
+String::size_type
+String::size() const
+{
+    return _rope ? _rope->length : _value.size();
+}
+
+void
+String::append(const String& rhs)
+{
+    if (size() + rhs.size() < rope_threshold) {
+        // Either of them may be a slice
+        if (_rope) {
+            _value = std::string(view());
+            _rope.reset();
+        }
+        _value.append(rhs.view());
+        return;
+    }
+    _rope = Node::join(to_node(), rhs.to_node());
+    _value.clear();
+}
+
+String
+String::substr(size_type pos, size_type len) const
+{
+    if (pos > size())
+        throw std::out_of_range("String::substr()");
+
+    len = std::min(len, size() - pos);
+    if (!_rope)
+        return String(_value.substr(pos, len));
+    return String(Node::sub(_rope, pos, len));
 }
 
 // +--------------------+
 //    Private Functions
 // +--------------------+
 
+String::node_ptr
+String::to_node() const
+{
+    if (_rope)
+        return _rope;
+    return Node::make_leaf(
+      std::make_shared<const std::string>(_value), 0, _value.size());
+}
+
 DataType*
 String::rawptr_clone() const
 {
+    // The slice outlives the other strings that refer the text, the copy
+    // takes its content only, so the rest of the text is released
+    if (_rope && _rope->is_leaf() && _rope->text.use_count() == 1 &&
+        _rope->length < _rope->text->size() / 2)
+        return new String(std::string(view()));
+
     return new String(*this);
 }
 
@@ -49,7 +311,7 @@ String::operator bool() const
 
 String::operator std::string() const
 {
-    return _value;
+    return const_value();
 }
 
 }
\ No newline at end of file
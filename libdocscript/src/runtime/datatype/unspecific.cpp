@@ -1,4 +1,5 @@
 #include "libdocscript/runtime/datatype.h"
+#include <new>
 #include <string>
 
 namespace libdocscript::runtime {
@@ -13,6 +14,12 @@ Unspecific::rawptr_clone() const
     return new Unspecific(*this);
 }
 
+DataType*
+Unspecific::rawptr_clone_to(void* buffer) const
+{
+    return new (buffer) Unspecific(*this);
+}
+
 // +--------------------+
 //    Type Conversion
 // +--------------------+
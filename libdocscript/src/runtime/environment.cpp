@@ -1,7 +1,6 @@
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/runtime/macro.h"
-#include <memory>
 #include <string>
 #include <utility>
 
@@ -22,6 +21,8 @@ Environment::find(const std::string& name, bool current_only)
 {
     auto iter = _value_dict.find(name);
     if (iter == _value_dict.end()) {
+        if (frame_slot(name))
+            return EnvironmentFindResult::ExistValue;
         if (!current_only && has_parent())
             return parent().find(name);
         else
@@ -47,7 +48,7 @@ Environment::parent()
 Environment&
 Environment::global()
 {
-    auto e = _parent;
+    auto e = this;
     while (e->has_parent()) {
         e = e->_parent;
     }
@@ -58,10 +59,38 @@ Environment
 Environment::derive()
 {
     Environment env;
-    env._parent = std::make_shared<Environment>(*this);
+    env._parent = this;
+    return env;
+}
+
+Environment
+Environment::derive(const std::vector<std::string>& names, Value* values)
+{
+    Environment env;
+    env._parent = this;
+    env._frame_names = &names;
+    env._frame_values = values;
     return env;
 }
 
+// +---------------------------+
+//      Private Functions
+// +---------------------------+
+
+// The names in the dictionary are looked up before the parameters, the
+// dictionary is empty in most lambda callings, so it costs nothing
+Value*
+Environment::frame_slot(const std::string& name)
+{
+    if (_frame_names == nullptr)
+        return nullptr;
+    for (decltype(_frame_names->size()) i = 0; i != _frame_names->size(); ++i) {
+        if ((*_frame_names)[i] == name)
+            return _frame_values + i;
+    }
+    return nullptr;
+}
+
 // +---------------------------+
 //       Static Functions
 // +---------------------------+
@@ -82,6 +111,8 @@ Environment::find<Macro>(const std::string& name, bool current_only)
 {
     auto iter = _value_dict.find(name);
     if (iter == _value_dict.end()) {
+        if (frame_slot(name))
+            return false;
         if (!current_only && has_parent())
             return parent().find<Macro>(name);
         else
@@ -95,7 +126,7 @@ template<>
 void
 Environment::set<Macro>(const std::string& name, Macro obj)
 {
-    _value_dict.insert_or_assign(name, obj);
+    _value_dict.insert_or_assign(name, std::move(obj));
 }
 
 template<>
@@ -125,6 +156,8 @@ Environment::find<Value>(const std::string& name, bool current_only)
 {
     auto iter = _value_dict.find(name);
     if (iter == _value_dict.end()) {
+        if (frame_slot(name))
+            return true;
         if (!current_only && has_parent())
             return parent().find<Value>(name);
         else
@@ -138,7 +171,13 @@ template<>
 void
 Environment::set<Value>(const std::string& name, Value obj)
 {
-    _value_dict.insert_or_assign(name, obj);
+    if (_value_dict.find(name) == _value_dict.end()) {
+        if (auto slot = frame_slot(name)) {
+            *slot = std::move(obj);
+            return;
+        }
+    }
+    _value_dict.insert_or_assign(name, std::move(obj));
 }
 
 template<>
@@ -151,6 +190,8 @@ Environment::get<Value>(const std::string& name, bool current_only)
     auto iter = _value_dict.find(name);
     if (iter != _value_dict.end()) {
         return std::get<Value>(iter->second);
+    } else if (auto slot = frame_slot(name)) {
+        return *slot;
     } else if (!current_only && has_parent()) {
         return parent().get<Value>(name, current_only);
     } else {
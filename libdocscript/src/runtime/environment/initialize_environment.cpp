@@ -1,4 +1,5 @@
 #include "libdocscript/proc/builtin.h"
+#include "libdocscript/runtime/datatype.h"
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/runtime/procedure.h"
 #include <string>
@@ -8,7 +9,47 @@ namespace libdocscript::runtime {
 Environment&
 initialize_environment(Environment& env)
 {
-    std::unordered_map<std::string, BuiltInProcedure::inner_type> procs{
+    using Kind = DataType::Kind;
+    using Signature = BuiltInProcedure::Signature;
+
+    // The number and the type of arguments
+    const auto any = Signature::any;
+    const Signature none{ 0, 0, any };
+    const Signature one_list{ 1, 1, Kind::List };
+    const Signature one_table{ 1, 1, Kind::Table };
+    const Signature one_vector{ 1, 1, Kind::Vector };
+    const Signature one_port{ 1, 1, Kind::Port };
+    const Signature strings_1{ 1, Signature::variadic, Kind::String };
+    const Signature two_strings{ 2, 2, Kind::String };
+    const Signature three_strings{ 3, 3, Kind::String };
+    const Signature numbers_0{ 0, Signature::variadic, Kind::Number };
+    const Signature numbers_1{ 1, Signature::variadic, Kind::Number };
+    const Signature numbers_2{ 2, Signature::variadic, Kind::Number };
+    const Signature numbers_1_3{ 1, 3, Kind::Number };
+    // The types of the arguments by their positions
+    const Signature list_number{ 2, 2, { Kind::List, Kind::Number } };
+    const Signature list_procedure_1{ 1, 2, { Kind::List, Kind::Procedure } };
+    const Signature procedure_list{ 2, 2, { Kind::Procedure, Kind::List } };
+    const Signature procedure_any_list{
+        3, 3, { Kind::Procedure, any, Kind::List }
+    };
+    const Signature table_any{ 2, 2, { Kind::Table, any } };
+    const Signature table_any_any{ 3, 3, { Kind::Table, any, any } };
+    const Signature table_any_any_2{ 2, 3, { Kind::Table, any, any } };
+    const Signature any_number{ 2, 2, { any, Kind::Number } };
+    const Signature vector_any{ 2, 2, { Kind::Vector, any } };
+    const Signature vector_number{ 2, 2, { Kind::Vector, Kind::Number } };
+    const Signature vector_number_any{
+        3, 3, { Kind::Vector, Kind::Number, any }
+    };
+    const Signature string_number_1{ 1, 2, { Kind::String, Kind::Number } };
+    const Signature string_port_1{ 1, 2, { Kind::String, Kind::Port } };
+    const Signature string_port{ 2, 2, { Kind::String, Kind::Port } };
+    const Signature strings_number_2{
+        2, 3, { Kind::String, Kind::String, Kind::Number }
+    };
+
+    std::unordered_map<std::string, BuiltInProcedure> procs{
         { "equal-type?", proc::equal_type },
         { "equal?", proc::equal },
 
@@ -28,14 +69,41 @@ initialize_environment(Environment& env)
         { "pair", proc::list_pair },
         { "first", proc::list_first },
         { "last", proc::list_last },
-        { "car", proc::list_car },
-        { "cdr", proc::list_cdr },
-        { "nth", proc::list_nth },
+        { "car", { proc::list_car, one_list } },
+        { "cdr", { proc::list_cdr, one_list } },
+        { "nth", { proc::list_nth, list_number } },
         { "length", proc::list_length },
         { "reverse", proc::list_reverse },
         { "concat", proc::list_concat },
         { "append", proc::list_append },
         { "empty?", proc::list_empty_is },
+        //
+        { "map", { proc::list_map, procedure_list } },
+        { "pmap", { proc::list_pmap, procedure_list } },
+        { "filter", { proc::list_filter, procedure_list } },
+        { "fold", { proc::list_fold, procedure_any_list } },
+        { "for-each", { proc::list_for_each, procedure_list } },
+        { "sort", { proc::list_sort, list_procedure_1 } },
+        { "stable-sort", { proc::list_stable_sort, list_procedure_1 } },
+
+        { "table?", proc::table_is },
+        { "make-table", { proc::table_make_table, none } },
+        { "table-ref", { proc::table_ref, table_any_any_2 } },
+        { "table-set!", { proc::table_set, table_any_any } },
+        { "table-has?", { proc::table_has_is, table_any } },
+        { "table-keys", { proc::table_keys, one_table } },
+        { "table->list", { proc::table_to_list, one_table } },
+
+        { "vector?", proc::vector_is },
+        { "vector->list", { proc::vector_to_list, one_vector } },
+        { "list->vector", { proc::list_to_vector, one_list } },
+        //
+        { "make-vector", { proc::vector_make_vector, any_number } },
+        { "vector", proc::vector_ },
+        { "vector-length", { proc::vector_length, one_vector } },
+        { "vector-ref", { proc::vector_ref, vector_number } },
+        { "vector-set!", { proc::vector_set, vector_number_any } },
+        { "vector-push!", { proc::vector_push, vector_any } },
 
         { "symbol?", proc::symbol_is },
         { "symbol=?", proc::symbol_eq },
@@ -43,25 +111,38 @@ initialize_environment(Environment& env)
         { "symbol->boolean", proc::symbol_to_boolean },
 
         { "string?", proc::string_is },
-        { "string=?", proc::string_eq },
+        { "string=?", { proc::string_eq, strings_1 } },
         { "string->symbol", proc::string_to_symbol },
         { "string->boolean", proc::string_to_boolean },
+        { "string->number", { proc::string_to_number, string_number_1 } },
         //
         { "make-string", proc::string_make_string },
         { "string-gt?", proc::string_gt_is },
         { "string-lt?", proc::string_lt_is },
         { "string-length", proc::string_length },
-        { "string-append", proc::string_concat },
-        { "string-concat", proc::string_concat },
+        { "string-append", { proc::string_concat, strings_1 } },
+        { "string-concat", { proc::string_concat, strings_1 } },
         { "string-ltrim", proc::string_ltrim },
         { "string-rtrim", proc::string_rtrim },
         { "string-trim", proc::string_trim },
         { "string-split", proc::string_split },
         { "substring", proc::string_substring },
+        { "string-index", { proc::string_index, strings_number_2 } },
+        { "string-contains?", { proc::string_contains_is, two_strings } },
+        { "string-count", { proc::string_count, two_strings } },
+        { "string-replace", { proc::string_replace, three_strings } },
+        { "html-escape", { proc::string_html_escape, string_port_1 } },
+        { "xml-escape", { proc::string_xml_escape, string_port_1 } },
+        { "tex-escape", { proc::string_tex_escape, string_port_1 } },
+
+        { "regex-match", { proc::regex_match, two_strings } },
+        { "regex-search", { proc::regex_search, two_strings } },
+        { "regex-replace", { proc::regex_replace, three_strings } },
+        { "regex-split", { proc::regex_split, two_strings } },
 
         { "number?", proc::number_is },
         { "number=?", proc::number_eq },
-        { "number->string", proc::number_to_string },
+        { "number->string", { proc::number_to_string, numbers_1_3 } },
         { "number->boolean", proc::number_to_boolean },
         //
         { "positive?", proc::number_positive_is },
@@ -72,10 +153,10 @@ initialize_environment(Environment& env)
         { "even?", proc::number_even_is },
         { "odd?", proc::number_odd_is },
         //
-        { "+", proc::number_add },
-        { "-", proc::number_minus },
-        { "*", proc::number_mul },
-        { "/", proc::number_div },
+        { "+", { proc::number_add, numbers_1 } },
+        { "-", { proc::number_minus, numbers_1 } },
+        { "*", { proc::number_mul, numbers_2 } },
+        { "/", { proc::number_div, numbers_2 } },
         { "quotient", proc::number_quotient },
         { "remainder", proc::number_remainder },
         { "modulo", proc::number_modulo },
@@ -90,11 +171,11 @@ initialize_environment(Environment& env)
         { "integer*", proc::number_integer_mul },
         { "integer/", proc::number_integer_div },
         //
-        { ">", proc::number_great_than },
-        { "<", proc::number_less_than },
-        { "=", proc::number_equal },
-        { ">=", proc::number_great_equal },
-        { "<=", proc::number_less_equal },
+        { ">", { proc::number_great_than, numbers_2 } },
+        { "<", { proc::number_less_than, numbers_2 } },
+        { "=", { proc::number_equal, numbers_2 } },
+        { ">=", { proc::number_great_equal, numbers_2 } },
+        { "<=", { proc::number_less_equal, numbers_2 } },
         //
         { "sin", proc::number_sin },
         { "cos", proc::number_cos },
@@ -106,14 +187,24 @@ initialize_environment(Environment& env)
         { "exp", proc::number_exp },
         { "log", proc::number_log },
         //
-        { "max", proc::number_max },
-        { "min", proc::number_min },
+        { "max", { proc::number_max, numbers_0 } },
+        { "min", { proc::number_min, numbers_0 } },
+        //
+        { "sum", { proc::number_sum, one_list } },
+        { "product", { proc::number_product, one_list } },
+        { "list-max", { proc::number_list_max, one_list } },
+        { "list-min", { proc::number_list_min, one_list } },
         //
         { "floor", proc::number_floor },
         { "ceiling", proc::number_ceiling },
         { "truncate", proc::number_truncate },
         { "round", proc::number_round },
 
+        { "port?", proc::port_is },
+        { "open-output-string", { proc::port_open_output_string, none } },
+        { "write-string", { proc::port_write_string, string_port } },
+        { "get-output-string", { proc::port_get_output_string, one_port } },
+
         { "procedure?", proc::procedure_is },
         { "procedure->string", proc::procedure_to_string },
         { "procedure->boolean", proc::procedure_to_boolean },
@@ -130,7 +221,7 @@ initialize_environment(Environment& env)
     };
 
     for (const auto& pair : procs) {
-        env.set(pair.first, Value(BuiltInProcedure(pair.second)));
+        env.set(pair.first, Value(pair.second));
     }
 
     return env;
@@ -1,45 +1,88 @@
 #include "libdocscript/runtime/list.h"
 #include "libdocscript/runtime/value.h"
-#include <sstream>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace libdocscript::runtime {
+namespace {
+// The storage of the packed list of the number, or Generic if it can't be
+// packed
+List::Storage
+storage_of(const Value& val)
+{
+    if (val.type() != DataType::Kind::Number)
+        return List::Generic;
+    return val.c_cast<Number>().type() == Number::Integer ? List::Integers
+                                                          : List::Decimals;
+}
+}
+
 // +--------------------+
 //      Constructor
 // +--------------------+
 
 List::List()
   : DataType(DataType::Kind::List)
+  , _storage(Integers)
 {}
 
 List::List(const raw_type& raw_list)
   : DataType(DataType::Kind::List)
+  , _storage(Integers)
 {
-    _raw.insert(_raw.begin(), raw_list.begin(), raw_list.end());
+    pack(raw_list.begin(), raw_list.end());
 }
 
 List::List(raw_type::const_iterator beg, raw_type::const_iterator end)
   : DataType(DataType::Kind::List)
+  , _storage(Integers)
 {
-    _raw.insert(_raw.begin(), beg, end);
+    pack(beg, end);
 }
 
+List::List(std::vector<Number::int_type> integers)
+  : DataType(DataType::Kind::List)
+  , _storage(Integers)
+  , _integers(std::move(integers))
+{}
+
+List::List(std::vector<Number::dec_type> decimals)
+  : DataType(DataType::Kind::List)
+  , _storage(Decimals)
+  , _decimals(std::move(decimals))
+{}
+
 List::List(const List& list)
   : DataType(DataType::Kind::List)
+  , _storage(list._storage.load(std::memory_order_acquire))
 {
-    for (const auto& e : list._raw) {
-        _raw.push_back(e);
+    // The packed buffer of the list unpacked by the const functions is kept,
+    // but only the representation loaded here is read
+    switch (_storage.load(std::memory_order_relaxed)) {
+        case Integers:
+            _integers = list._integers;
+            break;
+        case Decimals:
+            _decimals = list._decimals;
+            break;
+        default:
+            _raw = list._raw;
+            break;
     }
 }
 
 List::List(List&& list)
   : DataType(DataType::Kind::List)
+  , _storage(list._storage.load(std::memory_order_acquire))
+  , _raw(std::move(list._raw))
+  , _integers(std::move(list._integers))
+  , _decimals(std::move(list._decimals))
 {
-    for (const auto& e : list._raw) {
-        _raw.push_back(std::move(e));
-    }
+    if (_storage.load(std::memory_order_relaxed) == Generic)
+        drop_packed();
 }
 
 // +--------------------+
@@ -49,61 +92,216 @@ List::List(List&& list)
 List::raw_type&
 List::raw()
 {
+    unpack();
+    drop_packed();
     return _raw;
 }
 
 const List::raw_type&
 List::craw() const
 {
+    unpack();
     return _raw;
 }
 
-List::raw_type::size_type
+List::Storage
+List::storage() const
+{
+    return _storage.load(std::memory_order_acquire);
+}
+
+const std::vector<Number::int_type>&
+List::integers() const
+{
+    return _integers;
+}
+
+const std::vector<Number::dec_type>&
+List::decimals() const
+{
+    return _decimals;
+}
+
+List::size_type
 List::size() const
 {
-    return _raw.size();
+    switch (storage()) {
+        case Integers:
+            return _integers.size();
+        case Decimals:
+            return _decimals.size();
+        default:
+            return _raw.size();
+    }
+}
+
+Value
+List::at(size_type pos) const
+{
+    switch (storage()) {
+        case Integers:
+            return Number(_integers[pos]);
+        case Decimals:
+            return Number(_decimals[pos]);
+        default:
+            return _raw[pos];
+    }
+}
+
+List
+List::sublist(size_type pos) const
+{
+    List result;
+    switch (storage()) {
+        case Integers:
+            result._integers.assign(_integers.begin() + pos, _integers.end());
+            break;
+        case Decimals:
+            result._storage.store(Decimals, std::memory_order_relaxed);
+            result._decimals.assign(_decimals.begin() + pos, _decimals.end());
+            break;
+        default:
+            result._storage.store(Generic, std::memory_order_relaxed);
+            result._raw.assign(_raw.begin() + pos, _raw.end());
+            break;
+    }
+    return result;
+}
+
+void
+List::reserve(size_type n)
+{
+    switch (storage()) {
+        case Integers:
+            _integers.reserve(n);
+            break;
+        case Decimals:
+            _decimals.reserve(n);
+            break;
+        default:
+            _raw.reserve(n);
+            break;
+    }
 }
 
 void
 List::push_back(const Value& val)
 {
+    auto storage = this->storage();
+    if (storage != Generic) {
+        auto type = storage_of(val);
+        // The empty list of the integers becomes the list of the decimals
+        if (type == Decimals && storage == Integers && _integers.empty()) {
+            _storage.store(Decimals, std::memory_order_relaxed);
+            _decimals.reserve(_integers.capacity());
+            storage = Decimals;
+        }
+        if (type == storage) {
+            const auto& num = val.c_cast<Number>();
+            if (storage == Integers)
+                _integers.push_back(num.integer());
+            else
+                _decimals.push_back(num.decimal());
+            return;
+        }
+        unpack();
+    }
+    drop_packed();
     _raw.push_back(val);
 }
 
 void
 List::push_back(Value&& val)
 {
+    if (storage() != Generic) {
+        push_back(static_cast<const Value&>(val));
+        return;
+    }
+    drop_packed();
     _raw.push_back(std::move(val));
 }
 
 List::raw_type::iterator
 List::begin()
 {
-    return _raw.begin();
+    return raw().begin();
 }
 
 List::raw_type::iterator
 List::end()
 {
-    return _raw.end();
+    return raw().end();
 }
 
 List::raw_type::const_iterator
 List::cbegin() const
 {
-    return _raw.cbegin();
+    return craw().cbegin();
 }
 
 List::raw_type::const_iterator
 List::cend() const
 {
-    return _raw.cend();
+    return craw().cend();
 }
 
 // +--------------------+
 //   Private Functions
 // +--------------------+
 
+void
+List::pack(raw_type::const_iterator beg, raw_type::const_iterator end)
+{
+    auto storage = beg == end ? Integers : storage_of(*beg);
+    for (auto iter = beg; iter != end && storage != Generic; ++iter) {
+        if (storage_of(*iter) != storage)
+            storage = Generic;
+    }
+
+    _storage.store(storage, std::memory_order_relaxed);
+    if (storage == Generic) {
+        _raw.assign(beg, end);
+        return;
+    }
+    for (auto iter = beg; iter != end; ++iter) {
+        const auto& num = iter->c_cast<Number>();
+        if (storage == Integers)
+            _integers.push_back(num.integer());
+        else
+            _decimals.push_back(num.decimal());
+    }
+}
+
+void
+List::unpack() const
+{
+    // The list is unpacked once, the other threads reading it wait here
+    std::call_once(_unpacked, [this] {
+        switch (_storage.load(std::memory_order_relaxed)) {
+            case Integers:
+                _raw.reserve(_integers.size());
+                for (auto num : _integers)
+                    _raw.push_back(Number(num));
+                break;
+            case Decimals:
+                _raw.reserve(_decimals.size());
+                for (auto num : _decimals)
+                    _raw.push_back(Number(num));
+                break;
+            default:
+                return;
+        }
+        _storage.store(Generic, std::memory_order_release);
+    });
+}
+
+void
+List::drop_packed()
+{
+    std::vector<Number::int_type>().swap(_integers);
+    std::vector<Number::dec_type>().swap(_decimals);
+}
+
 DataType*
 List::rawptr_clone() const
 {
@@ -116,21 +314,20 @@ List::rawptr_clone() const
 
 List::operator bool() const
 {
-    return _raw.size() != 0;
+    return size() != 0;
 }
 
 List::operator std::string() const
 {
-    std::ostringstream oss;
-    oss << "(";
-    for (auto beg = _raw.begin(); beg != _raw.end(); ++beg) {
-        oss << static_cast<std::string>(*beg);
-        if (beg != _raw.end() - 1) {
-            oss << " ";
+    std::string result = "(";
+    for (size_type i = 0; i != size(); ++i) {
+        result += static_cast<std::string>(at(i));
+        if (i != size() - 1) {
+            result += " ";
         }
     }
-    oss << ")";
-    return oss.str();
+    result += ")";
+    return result;
 }
 
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "libdocscript/runtime/environment.h"
 #include "libdocscript/exception.h"
 #include <algorithm>
+#include <atomic>
 #include <string>
 
 namespace libdocscript::runtime {
@@ -19,6 +20,7 @@ using namespace ast;
 Macro::Macro(const param_list& names, ast::Expression expr)
   : _params(names)
   , _expression(expr)
+  , _serial(next_serial())
 {}
 
 // +-------------------+
@@ -30,4 +32,21 @@ Macro::parameters() const
 {
     return _params;
 }
+
+std::size_t
+Macro::serial() const
+{
+    return _serial;
+}
+
+// +-------------------+
+//   Static Functions
+// +-------------------+
+
+std::size_t
+Macro::next_serial()
+{
+    static std::atomic<std::size_t> serial{ 0 };
+    return ++serial;
+}
 } // namespace libdocscript
\ No newline at end of file
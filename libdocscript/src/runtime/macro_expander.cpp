@@ -5,24 +5,53 @@
 #include "libdocscript/ast/list.h"
 #include "libdocscript/exception.h"
 #include "libdocscript/runtime/environment.h"
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace libdocscript::runtime {
 
+namespace {
+// The run-time expansions being evaluated in this thread
+thread_local std::size_t expansion_depth = 0;
+
+MacroExpandingFailed
+too_deep(const std::string& name)
+{
+    return MacroExpandingFailed("the expansion of " + name +
+                                " is nested more than " +
+                                std::to_string(MacroExpander::max_depth) +
+                                " levels");
+}
+}
+
 // +--------------------+
 //      Constructor
 // +--------------------+
 
-MacroExpander::MacroExpander(Macro& macro,
-                             args_map& args,
-                             Environment& env,
-                             bool rec_expand)
+MacroExpander::MacroExpander(Macro& macro, args_map& args, Environment& env)
   : _env(env)
   , _macro(macro)
-  , _expand_recusrive(rec_expand)
   , _args(args)
 {}
 
+// +--------------------+
+//      DepthGuard
+// +--------------------+
+
+MacroExpander::DepthGuard::DepthGuard(const std::string& name)
+{
+    if (expansion_depth >= max_depth)
+        throw too_deep(name);
+    ++expansion_depth;
+}
+
+MacroExpander::DepthGuard::~DepthGuard()
+{
+    --expansion_depth;
+}
+
 // +--------------------+
 //    Static Functions
 // +--------------------+
@@ -31,16 +60,102 @@ ast::Expression
 MacroExpander::expand_1(Macro& macro, const args_list& args, Environment& env)
 {
     auto map = create_map(macro.parameters(), args);
-    auto expander = MacroExpander(macro, map, env, false);
+    auto expander = MacroExpander(macro, map, env);
     return expander.expand_expression(expander._macro._expression);
 }
 
 ast::Expression
 MacroExpander::expand(Macro& macro, const args_list& args, Environment& env)
 {
-    auto map = create_map(macro.parameters(), args);
-    auto expander = MacroExpander(macro, map, env, true);
-    return expander.expand_expression(expander._macro._expression);
+    return expand_all(expand_1(macro, args, env), env);
+}
+
+ast::Expression
+MacroExpander::expand_all(ast::Expression expr, Environment& env)
+{
+    // The macros that the node is expanded from, linked by the index of the
+    // outer one, -1 means not inside any expansion.
+    struct Origin
+    {
+        std::string name;
+        long long outer;
+    };
+
+    // The node inside the template of quasiquote is data, only the
+    // expressions of its unquote and unquote-splicing are expanded
+    struct Work
+    {
+        ast::Expression* node;
+        long long origin;
+        bool children_done;
+        bool quoted;
+    };
+
+    std::vector<Origin> origins;
+    std::vector<Work> works{ { &expr, -1, false, false } };
+    while (!works.empty()) {
+        auto work = works.back();
+        works.pop_back();
+
+        auto& node = *work.node;
+        if (node.type() != ast::ASTNodeType::List || is_define_macro(node))
+            continue;
+
+        auto& children = node.cast<ast::List>().raw();
+        auto form = form_of(node);
+        if (work.quoted || form == ast::AtomType::Quasiquote) {
+            bool hole = form == ast::AtomType::Unquote ||
+                        form == ast::AtomType::UnquoteSplicing;
+            bool quoted = !hole;
+            // The keyword of the form is skipped
+            auto first = children.begin() + (work.quoted && !hole ? 0 : 1);
+            for (auto child = first; child != children.end(); ++child) {
+                works.push_back({ &*child, work.origin, false, quoted });
+            }
+            continue;
+        }
+        if (form == ast::AtomType::Quote)
+            continue;
+
+        // Arguments first
+        if (!work.children_done) {
+            works.push_back({ work.node, work.origin, true, false });
+            for (auto& child : children) {
+                works.push_back({ &child, work.origin, false, false });
+            }
+            continue;
+        }
+
+        if (!is_macro_calling(node, env))
+            continue;
+
+        const auto& list = node.c_cast<ast::List>();
+        const auto& name = list.cbegin()->c_cast<ast::Atom>().content();
+        bool nested = false;
+        std::size_t depth = 0;
+        for (auto i = work.origin; i != -1; i = origins[i].outer) {
+            if (origins[i].name == name) {
+                nested = true;
+                break;
+            }
+            ++depth;
+        }
+        if (nested)
+            continue;
+        if (depth >= max_depth) {
+            auto e = too_deep(name);
+            e.locate((*node).position());
+            throw e;
+        }
+
+        auto expansion =
+          expand_1(env.get<Macro>(name), args_list(list.cbegin() + 1, list.cend()), env);
+        origins.push_back({ name, work.origin });
+        node = std::move(expansion);
+        works.push_back(
+          { work.node, static_cast<long long>(origins.size()) - 1, false, false });
+    }
+    return expr;
 }
 
 MacroExpander::args_map
@@ -63,6 +178,40 @@ MacroExpander::find_name(const std::string &name)
     return _args.find(name) != _args.end();
 }
 
+bool
+MacroExpander::is_macro_calling(const ast::Expression& expr, Environment& env)
+{
+    if (expr.type() != ast::ASTNodeType::List)
+        return false;
+
+    const auto& list = expr.c_cast<ast::List>();
+    if (list.is_textlist || list.is_empty())
+        return false;
+
+    const auto& first = *list.cbegin();
+    return first.type() == ast::ASTNodeType::Atom &&
+           first.c_cast<ast::Atom>().atom_type() == ast::AtomType::Symbol &&
+           env.find<Macro>(first.c_cast<ast::Atom>().content());
+}
+
+ast::AtomType
+MacroExpander::form_of(const ast::Expression& expr)
+{
+    const auto& list = expr.c_cast<ast::List>();
+    if (list.is_empty() || list.cbegin()->type() != ast::ASTNodeType::Atom)
+        return ast::AtomType::Nil;
+    return list.cbegin()->c_cast<ast::Atom>().atom_type();
+}
+
+bool
+MacroExpander::is_define_macro(const ast::Expression& expr)
+{
+    const auto& list = expr.c_cast<ast::List>();
+    return !list.is_empty() && list.cbegin()->type() == ast::ASTNodeType::Atom &&
+           list.cbegin()->c_cast<ast::Atom>().atom_type() ==
+             ast::AtomType::DefineMacro;
+}
+
 // +--------------------+
 //   Private Functions
 // +--------------------+
@@ -91,24 +240,14 @@ MacroExpander::expand_atom(const ast::Atom& atom)
 ast::Expression
 MacroExpander::expand_list(const ast::List& list)
 {
-    // Enable Expand Recursive : Trying to expand other macros
-    if (_expand_recusrive && list.size() != 0) {
-        auto first = list.cbegin();
-        if (first->type() == ast::ASTNodeType::Atom &&
-            first->c_cast<ast::Atom>().atom_type() == ast::AtomType::Symbol &&
-            _env.find<Macro>(first->c_cast<ast::Atom>().content())) {
-            Macro& macro =
-              _env.get<Macro>(first->c_cast<ast::Atom>().content());
-            return MacroExpander::expand(
-              macro, args_list(list.cbegin() + 1, list.cend()), _env);
-        }
-    }
-    // Normal Expand Recursive : Expand expression tree
+    // Expand expression tree
     ast::List result;
+    result.set_position(list.position());
     for (decltype(list.size()) i = 0; i != list.size(); ++i) {
         auto& elem = list.craw()[i];
         result.push_back(expand_expression(elem));
     }
+    result.prepare_expansion_cache();
     return result;
 }
 
@@ -1,6 +1,9 @@
+#include "libdocscript/exception.h"
 #include "libdocscript/runtime/datatype.h"
 #include "libdocscript/runtime/procedure.h"
 #include "libdocscript/runtime/value.h"
+#include <cstddef>
+#include <initializer_list>
 
 namespace libdocscript::runtime {
 
@@ -8,26 +11,93 @@ namespace libdocscript::runtime {
 //       Constructor
 // +--------------------+
 
+BuiltInProcedure::Signature::Signature(std::size_t min_args,
+                                       std::size_t max_args,
+                                       kind_type rest)
+  : _min_args(min_args)
+  , _max_args(max_args)
+  , _rest(rest)
+{}
+
+BuiltInProcedure::Signature::Signature(
+  std::size_t min_args,
+  std::size_t max_args,
+  std::initializer_list<kind_type> positions,
+  kind_type rest)
+  : _min_args(min_args)
+  , _max_args(max_args)
+  , _rest(rest)
+{
+    if (positions.size() > max_positions)
+        throw InternalUnimplementException("BuiltInProcedure::Signature()");
+    for (auto kind : positions) {
+        _positions[_position_count++] = kind;
+    }
+}
+
 BuiltInProcedure::BuiltInProcedure(inner_type func)
+  : BuiltInProcedure(func, Signature())
+{}
+
+BuiltInProcedure::BuiltInProcedure(inner_type func, Signature signature)
   : Procedure(Procedure::BuiltIn)
   , _func(func)
+  , _signature(signature)
 {}
 
 // +--------------------+
 //    Public Functions
 // +--------------------+
 
+std::size_t
+BuiltInProcedure::Signature::min_args() const
+{
+    return _min_args;
+}
+
+std::size_t
+BuiltInProcedure::Signature::max_args() const
+{
+    return _max_args;
+}
+
+BuiltInProcedure::Signature::kind_type
+BuiltInProcedure::Signature::kind(std::size_t index) const
+{
+    return index < _position_count ? _positions[index] : _rest;
+}
+
 Value
 BuiltInProcedure::invoke(const args_list& args, Environment& env) const
 {
-    Environment subenv = env.derive();
-    return _func(args, subenv);
+    check_signature(args);
+    return _func(args, env);
 }
 
 // +--------------------+
 //    Private Functions
 // +--------------------+
 
+void
+BuiltInProcedure::check_signature(const args_list& args) const
+{
+    const auto& sig = _signature;
+    if (args.size() < sig.min_args()) {
+        if (sig.min_args() == sig.max_args())
+            throw UnexceptNumberOfArgument(sig.min_args(), args.size());
+        throw UnexceptNumberOfArgument(sig.min_args(), args.size(), true);
+    }
+    if (args.size() > sig.max_args())
+        throw UnexceptNumberOfArgument(sig.max_args(), args.size());
+
+    for (std::size_t i = 0; i != args.size(); ++i) {
+        auto kind = sig.kind(i);
+        if (kind && args[i].type() != *kind)
+            throw UnexceptType(DataType::to_string(*kind),
+                               DataType::to_string(args[i].type()));
+    }
+}
+
 DataType*
 BuiltInProcedure::rawptr_clone() const
 {
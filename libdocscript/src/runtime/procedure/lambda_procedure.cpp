@@ -23,10 +23,8 @@ Value LambdaProcedure::invoke(const args_list &args, Environment &env) const
     if(_parameters.size() != args.size()) {
         throw UnexceptNumberOfArgument(_parameters.size(), args.size());
     }
-    Environment subenv = env.derive();
-    for(decltype(_parameters.size()) i = 0; i != _parameters.size(); ++i) {
-        subenv.set<Value>(_parameters[i], args[i]);
-    }
+    // The parameters are bound to the slots of the arguments in place
+    Environment subenv = env.derive(_parameters, args.begin());
     return Interpreter(subenv).eval(_expression);
 }
 
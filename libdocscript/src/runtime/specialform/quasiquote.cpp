@@ -9,78 +9,137 @@
 #include "libdocscript/runtime/list.h"
 #include "libdocscript/runtime/specialform.h"
 #include "libdocscript/runtime/value.h"
+#include <memory>
+#include <mutex>
+#include <utility>
 
 namespace libdocscript::runtime::specialform {
 Quasiquote::Quasiquote(const ast::List& list)
   : SpecialForm(list)
+  , _list(list)
 {
     if (list.size() != 2)
         throw BadSyntax(form_name());
-
-    _expr = list.craw()[1];
 }
 
 Value
 Quasiquote::operator()(Environment& env)
 {
-    return Quasiquote::process(_expr, env, 1);
+    const auto& cache = _list.expansion_cache();
+    if (!cache) {
+        return QuasiquotePlan(_list.craw()[1], env)(env);
+    }
+
+    std::shared_ptr<const QuasiquotePlan> plan;
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if (!cache->quasiquote) {
+            cache->quasiquote =
+              std::make_shared<const QuasiquotePlan>(_list.craw()[1], env);
+        }
+        plan = cache->quasiquote;
+    }
+    return (*plan)(env);
+}
+
+QuasiquotePlan::QuasiquotePlan(const ast::Expression& expr, Environment& env)
+  : _root(compile(expr, env, 1))
+{}
+
+Value
+QuasiquotePlan::operator()(Environment& env) const
+{
+    return apply(_root, env);
 }
 
 // +--------------------+
 //    Static Functions
 // +--------------------+
 
-Value
-Quasiquote::process(const ast::Expression& expr, Environment& env, int depth)
+QuasiquotePlan::Segment
+QuasiquotePlan::compile(const ast::Expression& expr, Environment& env, int depth)
 {
     if (expr.type() == ast::ASTNodeType::Atom) {
-        return Quote::process_atom(expr.c_cast<ast::Atom>(), env);
-    } else {
-        return Quasiquote::process_list(expr.c_cast<ast::List>(), env, depth);
+        return { SegmentType::Constant,
+                 std::make_shared<const Value>(
+                   Quote::process_atom(expr.c_cast<ast::Atom>(), env)),
+                 nullptr,
+                 {} };
     }
+
+    const auto& list = expr.c_cast<ast::List>();
+    if (Quasiquote::is_unquote(list)) {
+        // Check the syntax of unquote
+        Unquote check(list);
+        return { SegmentType::Unquote,
+                 nullptr,
+                 std::make_shared<const ast::Expression>(list.craw()[1]),
+                 {} };
+    }
+
+    if (Quasiquote::is_splicing(list)) {
+        if (depth == 1)
+            throw UnquoteSplicingInvalid("invalid context within quasiquote");
+        // Check the syntax of unquote-splicing
+        UnquoteSplicing check(list);
+        return { SegmentType::Splicing,
+                 nullptr,
+                 std::make_shared<const ast::Expression>(list.craw()[1]),
+                 {} };
+    }
+
+    Segment segment{ SegmentType::List, nullptr, nullptr, {} };
+    bool constant = true;
+    for (const auto& e : list.craw()) {
+        segment.elements.push_back(compile(e, env, depth + 1));
+        constant = constant &&
+                   segment.elements.back().type == SegmentType::Constant;
+    }
+
+    // The list without unquote is built only once
+    if (constant) {
+        List result;
+        for (const auto& element : segment.elements)
+            result.push_back(*element.constant);
+        return { SegmentType::Constant,
+                 std::make_shared<const Value>(std::move(result)),
+                 nullptr,
+                 {} };
+    }
+    return segment;
 }
 
 Value
-Quasiquote::process_list(const ast::List& list, Environment& env, int depth)
+QuasiquotePlan::apply(const Segment& segment, Environment& env)
 {
-    if (is_unquote(list)) {
-        return Unquote(list)(env);
-    }
-
-    if (is_splicing(list)) {
-        if (depth == 1) {
+    switch (segment.type) {
+        case SegmentType::Constant:
+            return *segment.constant;
+        case SegmentType::Unquote:
+            return Interpreter(env).eval(*segment.expr);
+        case SegmentType::Splicing:
             throw UnquoteSplicingInvalid("invalid context within quasiquote");
-        } else {
-            return UnquoteSplicing(list)(env);
-        }
+        default:
+            break;
     }
 
     List result;
-    bool atom_unsplicing = false;
-    for (const auto& expr : list.craw()) {
-        auto value = process(expr, env, depth + 1);
-        if (expr.type() == ast::ASTNodeType::Atom) {
-            result.push_back(value);
+    for (const auto& element : segment.elements) {
+        if (element.type != SegmentType::Splicing) {
+            result.push_back(apply(element, env));
+            continue;
+        }
+
+        // Expand the list of the unquote-spcling result
+        auto value = Interpreter(env).eval(*element.expr);
+        if (value.type() == DataType::Kind::List) {
+            for (const auto& val : value.c_cast<List>().craw())
+                result.push_back(val);
         } else {
-            auto& list_expr = expr.c_cast<ast::List>();
-            // Expand the list of the unquote-spcling result
-            if (is_splicing(list_expr)) {
-                auto inner_value =
-                  UnquoteSplicing::expose_list(value.c_cast<List>());
-                if (inner_value.type() == DataType::Kind::List) {
-                    for (const auto& val : inner_value.c_cast<List>().craw())
-                        result.push_back(val);
-                } else {
-                    atom_unsplicing = true;
-                    result.push_back(inner_value);
-                }
-            } else {
-                result.push_back(value);
-            }
+            result.push_back(value);
         }
     }
-
-        return result;
+    return result;
 }
 
 bool
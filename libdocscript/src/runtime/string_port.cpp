@@ -0,0 +1,76 @@
+#include "libdocscript/runtime/string_port.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace libdocscript::runtime {
+// +--------------------+
+//      Constructor
+// +--------------------+
+
+StringPort::StringPort()
+  : DataType(DataType::Kind::Port)
+  , _buffer(std::make_shared<Buffer>())
+{}
+
+// +--------------------+
+//    Public Functions
+// +--------------------+
+
+void
+StringPort::write(std::string_view str)
+{
+    auto& chunks = _buffer->chunks;
+    if (chunks.empty() ||
+        chunks.back().capacity() - chunks.back().size() < str.size()) {
+        // The string longer than a chunk takes a chunk of its own
+        chunks.emplace_back();
+        chunks.back().reserve(std::max(chunk_capacity, str.size()));
+    }
+    chunks.back().append(str);
+    _buffer->size += str.size();
+}
+
+std::string
+StringPort::str() const
+{
+    std::string result;
+    result.reserve(_buffer->size);
+    for (const auto& chunk : _buffer->chunks) {
+        result.append(chunk);
+    }
+    return result;
+}
+
+StringPort::size_type
+StringPort::size() const
+{
+    return _buffer->size;
+}
+
+// +--------------------+
+//   Private Functions
+// +--------------------+
+
+DataType*
+StringPort::rawptr_clone() const
+{
+    return new StringPort(*this);
+}
+
+// +--------------------+
+//    Type Conversion
+// +--------------------+
+
+StringPort::operator bool() const
+{
+    return true;
+}
+
+StringPort::operator std::string() const
+{
+    return "#port";
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "libdocscript/runtime/table.h"
+#include "libdocscript/exception.h"
+#include "libdocscript/runtime/list.h"
+#include "libdocscript/runtime/value.h"
+#include "libdocscript/runtime/vector.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace libdocscript::runtime {
+
+namespace {
+// NaN is never equal to itself, so the key with NaN inside could never be
+// found again
+bool
+has_nan(const Value& val)
+{
+    switch (val.type()) {
+        case DataType::Kind::Number:
+            return std::isnan(val.c_cast<Number>().decimal());
+        case DataType::Kind::List: {
+            const auto& list = val.c_cast<List>();
+            if (list.storage() == List::Integers)
+                return false;
+            if (list.storage() == List::Decimals) {
+                const auto& nums = list.decimals();
+                return std::any_of(nums.begin(), nums.end(), [](auto num) {
+                    return std::isnan(num);
+                });
+            }
+            const auto& elems = list.craw();
+            return std::any_of(elems.begin(), elems.end(), has_nan);
+        }
+        case DataType::Kind::Vector: {
+            const auto& elems = val.c_cast<Vector>().craw();
+            return std::any_of(elems.begin(), elems.end(), has_nan);
+        }
+        default:
+            return false;
+    }
+}
+}
+// +--------------------+
+//      Constructor
+// +--------------------+
+
+Table::Table()
+  : DataType(DataType::Kind::Table)
+  , _entries(std::make_shared<Entries>())
+{}
+
+// +--------------------+
+//    Public Functions
+// +--------------------+
+
+const Table::raw_type&
+Table::craw() const
+{
+    return _entries->entries;
+}
+
+Table::size_type
+Table::size() const
+{
+    return _entries->entries.size();
+}
+
+const Value*
+Table::find(const Value& key) const
+{
+    auto iter = _entries->index.find(key);
+    if (iter == _entries->index.end())
+        return nullptr;
+    return &_entries->entries[iter->second].second;
+}
+
+void
+Table::set(const Value& key, const Value& val)
+{
+    if (has_nan(key))
+        throw RuntimeError("the key of table contains nan: " +
+                           static_cast<std::string>(key));
+
+    auto [iter, inserted] =
+      _entries->index.emplace(key, _entries->entries.size());
+    if (inserted) {
+        _entries->entries.emplace_back(key, val);
+    } else {
+        _entries->entries[iter->second].second = val;
+    }
+}
+
+// +--------------------+
+//   Private Functions
+// +--------------------+
+
+std::size_t
+Table::KeyHash::operator()(const Value& key) const
+{
+    return key.hash();
+}
+
+bool
+Table::KeyEqual::operator()(const Value& lhs, const Value& rhs) const
+{
+    return lhs == rhs;
+}
+
+DataType*
+Table::rawptr_clone() const
+{
+    return new Table(*this);
+}
+
+// +--------------------+
+//    Type Conversion
+// +--------------------+
+
+Table::operator bool() const
+{
+    return true;
+}
+
+Table::operator std::string() const
+{
+    return "#table";
+}
+
+}
\ No newline at end of file
@@ -1,29 +1,95 @@
 #include "libdocscript/runtime/value.h"
 #include "libdocscript/runtime/list.h"
+#include "libdocscript/runtime/string_port.h"
+#include "libdocscript/runtime/table.h"
+#include "libdocscript/runtime/vector.h"
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace libdocscript::runtime {
 
+namespace {
+// The element of the packed list as the decimal, the integer and the decimal
+// of the same value are equal
+Number::dec_type
+packed_decimal(const List& list, List::size_type i)
+{
+    if (list.storage() == List::Integers)
+        return static_cast<Number::dec_type>(list.integers()[i]);
+    return list.decimals()[i];
+}
+
+// The packed lists are compared without unpacking them, the unpacked one is
+// compared to the numbers of the packed one
+bool
+list_equal(const List& lhs, const List& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    auto lhs_packed = lhs.storage() != List::Generic;
+    auto rhs_packed = rhs.storage() != List::Generic;
+    if (lhs_packed && rhs_packed) {
+        if (lhs.storage() == List::Integers && rhs.storage() == List::Integers)
+            return lhs.integers() == rhs.integers();
+        for (List::size_type i = 0; i != lhs.size(); ++i) {
+            if (packed_decimal(lhs, i) != packed_decimal(rhs, i))
+                return false;
+        }
+        return true;
+    }
+
+    if (lhs_packed || rhs_packed) {
+        const auto& packed = lhs_packed ? lhs : rhs;
+        const auto& elems = lhs_packed ? rhs.craw() : lhs.craw();
+        for (List::size_type i = 0; i != elems.size(); ++i) {
+            if (elems[i].type() != DataType::Kind::Number ||
+                elems[i].c_cast<Number>().decimal() != packed_decimal(packed, i))
+                return false;
+        }
+        return true;
+    }
+
+    const auto& lhs_elems = lhs.craw();
+    const auto& rhs_elems = rhs.craw();
+    for (List::size_type i = 0; i != lhs_elems.size(); ++i) {
+        if (lhs_elems[i] != rhs_elems[i])
+            return false;
+    }
+    return true;
+}
+}
+
 // +--------------------+
 //      Constructor
 // +--------------------+
 
 Value::Value(const DataType& dt)
-  : _ptr(dt.rawptr_clone())
-{}
+  : _ptr(nullptr)
+  , _is_inline(false)
+{
+    assign(dt);
+}
 
 // +--------------------+
 //      Copy Control
 // +--------------------+
 
 Value::Value(const Value& val)
-  : _ptr(val._ptr->rawptr_clone())
-{}
+  : _ptr(nullptr)
+  , _is_inline(false)
+{
+    assign(*val._ptr);
+}
 
 Value::Value(Value&& val)
-  : _ptr(val._ptr)
+  : _ptr(nullptr)
+  , _is_inline(false)
 {
-    val._ptr = nullptr;
+    take(std::move(val));
 }
 
 // +--------------------+
@@ -32,9 +98,7 @@ Value::Value(Value&& val)
 
 Value::~Value()
 {
-    if (_ptr) {
-        delete _ptr;
-    }
+    release();
 }
 
 // +--------------------+
@@ -44,26 +108,25 @@ Value::~Value()
 Value&
 Value::operator=(const Value& rhs)
 {
-    if (_ptr && _ptr != rhs._ptr) {
-        delete _ptr;
-    }
-    _ptr = rhs._ptr->rawptr_clone();
+    // The rhs may be a part of this value
+    Value copy(rhs);
+    release();
+    take(std::move(copy));
     return *this;
 }
 
 Value&
 Value::operator=(Value&& rhs)
 {
-    if (_ptr) {
-        delete _ptr;
-    }
-    _ptr = rhs._ptr;
-    rhs._ptr = nullptr;
+    // The rhs may be a part of this value
+    Value moved(std::move(rhs));
+    release();
+    take(std::move(moved));
     return *this;
 }
 
 bool
-Value::operator==(const Value& rhs)
+Value::operator==(const Value& rhs) const
 {
     if (type() != rhs.type())
         return false;
@@ -85,24 +148,23 @@ Value::operator==(const Value& rhs)
             return c_cast<Boolean>().value() == rhs.c_cast<Boolean>().value();
 
         case DataType::Kind::String:
-            return c_cast<String>().const_value() ==
-                   rhs.c_cast<String>().const_value();
+            return c_cast<String>().view() == rhs.c_cast<String>().view();
 
         case DataType::Kind::Number:
             return c_cast<Number>().decimal() == rhs.c_cast<Number>().decimal();
 
-        case DataType::Kind::List: {
-            const auto& self = c_cast<List>();
-            const auto& rhs_list = rhs.c_cast<List>();
-            for (decltype(self.size()) i = 0; i != self.size(); ++i) {
-                const auto& self_elem = self.craw()[i];
-                const auto& rhs_elem = rhs_list.craw()[i];
-                if (self_elem != rhs_elem) {
-                    return false;
-                }
-            }
-            return true;
-        }
+        case DataType::Kind::List:
+            return list_equal(c_cast<List>(), rhs.c_cast<List>());
+
+        case DataType::Kind::Table:
+            return c_cast<Table>()._entries == rhs.c_cast<Table>()._entries;
+
+        case DataType::Kind::Vector:
+            return c_cast<Vector>()._raw == rhs.c_cast<Vector>()._raw;
+
+        case DataType::Kind::Port:
+            return c_cast<StringPort>()._buffer ==
+                   rhs.c_cast<StringPort>()._buffer;
 
         default:
             throw InternalUnimplementException("Value::operator==()");
@@ -110,7 +172,7 @@ Value::operator==(const Value& rhs)
 }
 
 bool
-Value::operator!=(const Value &rhs)
+Value::operator!=(const Value &rhs) const
 {
     return !(this->operator==(rhs));
 }
@@ -125,6 +187,101 @@ Value::type() const
     return _ptr->_kind;
 }
 
+std::size_t
+Value::hash() const
+{
+    auto kind_hash = std::hash<int>()(static_cast<int>(type()));
+    switch (type()) {
+        case DataType::Kind::Unspecific:
+        case DataType::Kind::Nil:
+        case DataType::Kind::Procedure:
+            return kind_hash;
+
+        case DataType::Kind::Error:
+            return std::hash<std::string>()(c_cast<Error>().message());
+
+        case DataType::Kind::Symbol:
+            return std::hash<std::string>()(c_cast<Symbol>().const_content());
+
+        case DataType::Kind::Boolean:
+            return std::hash<bool>()(c_cast<Boolean>().value());
+
+        case DataType::Kind::String:
+            return std::hash<std::string_view>()(c_cast<String>().view());
+
+        // The integer and the decimal of the same value are equal
+        case DataType::Kind::Number:
+            return std::hash<Number::dec_type>()(c_cast<Number>().decimal());
+
+        // The packed list has the same hash as the unpacked one
+        case DataType::Kind::List: {
+            auto result = kind_hash;
+            const auto& list = c_cast<List>();
+            if (list.storage() != List::Generic) {
+                for (List::size_type i = 0; i != list.size(); ++i) {
+                    result = result * 31 + std::hash<Number::dec_type>()(
+                                             packed_decimal(list, i));
+                }
+                return result;
+            }
+            for (const auto& elem : list.craw()) {
+                result = result * 31 + elem.hash();
+            }
+            return result;
+        }
+
+        case DataType::Kind::Table:
+            return std::hash<const void*>()(c_cast<Table>()._entries.get());
+
+        case DataType::Kind::Vector:
+            return std::hash<const void*>()(c_cast<Vector>()._raw.get());
+
+        case DataType::Kind::Port:
+            return std::hash<const void*>()(c_cast<StringPort>()._buffer.get());
+
+        default:
+            throw InternalUnimplementException("Value::hash()");
+    }
+}
+
+// +--------------------+
+//   Private Functions
+// +--------------------+
+
+void
+Value::assign(const DataType& dt)
+{
+    _ptr = dt.rawptr_clone_to(&_storage);
+    _is_inline = _ptr != nullptr;
+    if (!_is_inline) {
+        _ptr = dt.rawptr_clone();
+    }
+}
+
+void
+Value::take(Value&& val)
+{
+    if (val._is_inline) {
+        assign(*val._ptr);
+    } else {
+        _ptr = val._ptr;
+        _is_inline = false;
+        val._ptr = nullptr;
+    }
+}
+
+void
+Value::release()
+{
+    if (_is_inline) {
+        _ptr->~DataType();
+    } else if (_ptr) {
+        delete _ptr;
+    }
+    _ptr = nullptr;
+    _is_inline = false;
+}
+
 // +--------------------+
 //    Type Conversion
 // +--------------------+
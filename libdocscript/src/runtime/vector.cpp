@@ -0,0 +1,67 @@
+#include "libdocscript/runtime/vector.h"
+#include "libdocscript/runtime/value.h"
+#include <memory>
+#include <string>
+
+namespace libdocscript::runtime {
+// +--------------------+
+//      Constructor
+// +--------------------+
+
+Vector::Vector()
+  : DataType(DataType::Kind::Vector)
+  , _raw(std::make_shared<raw_type>())
+{}
+
+Vector::Vector(raw_type::const_iterator beg, raw_type::const_iterator end)
+  : DataType(DataType::Kind::Vector)
+  , _raw(std::make_shared<raw_type>(beg, end))
+{}
+
+// +--------------------+
+//    Public Functions
+// +--------------------+
+
+Vector::raw_type&
+Vector::raw()
+{
+    return *_raw;
+}
+
+const Vector::raw_type&
+Vector::craw() const
+{
+    return *_raw;
+}
+
+Vector::raw_type::size_type
+Vector::size() const
+{
+    return _raw->size();
+}
+
+// +--------------------+
+//   Private Functions
+// +--------------------+
+
+DataType*
+Vector::rawptr_clone() const
+{
+    return new Vector(*this);
+}
+
+// +--------------------+
+//    Type Conversion
+// +--------------------+
+
+Vector::operator bool() const
+{
+    return true;
+}
+
+Vector::operator std::string() const
+{
+    return "#vector";
+}
+
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "libdocscript/scanner.h"
+#include "libdocscript/exception.h"
 #include "libdocscript/token.h"
 #include <memory>
 #include <sstream>
@@ -24,8 +25,17 @@ Scanner::Scanner(StringStream& stream)
 Token
 Scanner::get()
 {
-    auto& adapter = get_adapter();
-    return adapter.scan();
+    // An unfinished token never changes the mode stack (modes are only
+    // switched by the bracket symbols), so rewinding the stream is enough to
+    // let the token be scanned again once more input arrives.
+    _stream.mark();
+    try {
+        auto& adapter = get_adapter();
+        return adapter.scan();
+    } catch (const UnfinishedInput&) {
+        _stream.rewind();
+        throw;
+    }
 }
 
 void
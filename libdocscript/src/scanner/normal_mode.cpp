@@ -269,7 +269,7 @@ ScannerNormalMode::scan_integer(std::string& content)
         // --> Decimal
         else if (ch == '.') {
             Token resultToken;
-            if (!stream.last() && is_digit(stream.peek())) {
+            if (!stream.last() && is_digit(stream.peek_next())) {
                 resultToken = scan_decimal(content);
             } else {
                 resultToken = scan_id_valid_letter(content);
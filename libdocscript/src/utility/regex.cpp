@@ -0,0 +1,659 @@
+#include "libdocscript/utility/regex.h"
+#include "libdocscript/exception.h"
+#include <bitset>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace libdocscript {
+
+namespace {
+// The counted quantifiers copy their operand, so the size of program is
+// limited to keep a pattern like (a{1000}){1000} from using all the memory
+constexpr std::size_t max_program_size = 20000;
+constexpr std::size_t max_count = 1000;
+// The groups are parsed recursively, so the nesting of them is limited to
+// keep a pattern like ((((...)))) from overflowing the stack
+constexpr std::size_t max_group_depth = 256;
+
+bool
+is_word(unsigned char ch)
+{
+    return std::isalnum(ch) || ch == '_';
+}
+
+bool
+is_digit(char ch)
+{
+    return std::isdigit(static_cast<unsigned char>(ch));
+}
+
+// The set of \d \w \s, or an empty set if it isn't one of them
+std::bitset<256>
+escape_set(char ch)
+{
+    std::bitset<256> set;
+    switch (std::tolower(static_cast<unsigned char>(ch))) {
+        case 'd':
+            for (int c = '0'; c <= '9'; ++c)
+                set.set(c);
+            break;
+        case 'w':
+            for (int c = 0; c < 256; ++c)
+                set[c] = is_word(c);
+            break;
+        case 's':
+            for (unsigned char c : std::string_view(" \t\n\r\f\v"))
+                set.set(c);
+            break;
+        default:
+            return set;
+    }
+    return std::isupper(static_cast<unsigned char>(ch)) ? ~set : set;
+}
+
+bool
+is_set_escape(char ch)
+{
+    return std::string_view("dDwWsS").find(ch) != std::string_view::npos;
+}
+}
+
+// +--------------------+
+//       Compiler
+// +--------------------+
+
+class Regex::Compiler
+{
+  public:
+    Compiler(Regex& regex, std::string_view pattern)
+      : _regex(regex)
+      , _pattern(pattern)
+      , _pos(0)
+      , _depth(0)
+    {}
+
+    void compile()
+    {
+        auto node = parse_alternation();
+        if (_pos != _pattern.size())
+            throw InvalidRegex("unmatched )");
+
+        push({Opcode::Save, 0, 0});
+        emit(node);
+        push({Opcode::Save, 0, 1});
+        push({Opcode::Match});
+    }
+
+  private:
+    struct Node
+    {
+        enum Type
+        {
+            Char,
+            Any,
+            Class,
+            Begin,
+            End,
+            WordBoundary,
+            NotWordBoundary,
+            Concat,
+            Alternation,
+            Repeat,
+            Group
+        };
+
+        explicit Node(Type t)
+          : type(t)
+        {}
+
+        Type type;
+        unsigned char ch = 0;
+        // The index of class, or the number of group
+        size_type index = 0;
+        size_type min = 0;
+        size_type max = 0;
+        bool greedy = true;
+        bool capture = false;
+        std::vector<Node> children;
+    };
+
+    Regex& _regex;
+    std::string_view _pattern;
+    size_type _pos;
+    // The number of the groups enclosing the position
+    size_type _depth;
+
+    bool eof() const { return _pos == _pattern.size(); }
+    char peek() const { return _pattern[_pos]; }
+
+    // +--------------------+
+    //        Parser
+    // +--------------------+
+
+    Node parse_alternation()
+    {
+        Node alt{Node::Alternation};
+        alt.children.push_back(parse_concat());
+        while (!eof() && peek() == '|') {
+            ++_pos;
+            alt.children.push_back(parse_concat());
+        }
+
+        if (alt.children.size() == 1)
+            return std::move(alt.children.front());
+        return alt;
+    }
+
+    Node parse_concat()
+    {
+        Node cat{Node::Concat};
+        while (!eof() && peek() != '|' && peek() != ')') {
+            cat.children.push_back(parse_repeat());
+        }
+
+        if (cat.children.size() == 1)
+            return std::move(cat.children.front());
+        return cat;
+    }
+
+    Node parse_repeat()
+    {
+        auto atom = parse_atom();
+        for (bool repeated = false; !eof(); repeated = true) {
+            size_type min, max;
+            switch (peek()) {
+                case '*':
+                    min = 0, max = npos, ++_pos;
+                    break;
+                case '+':
+                    min = 1, max = npos, ++_pos;
+                    break;
+                case '?':
+                    min = 0, max = 1, ++_pos;
+                    break;
+                case '{':
+                    if (!parse_count(min, max))
+                        return atom;
+                    break;
+                default:
+                    return atom;
+            }
+
+            // The quantifiers can't be stacked, so the nesting of nodes is
+            // limited by the groups
+            if (repeated)
+                throw InvalidRegex("multiple repeat");
+
+            switch (atom.type) {
+                case Node::Begin:
+                case Node::End:
+                case Node::WordBoundary:
+                case Node::NotWordBoundary:
+                    throw InvalidRegex("nothing to repeat");
+                default:
+                    break;
+            }
+
+            Node repeat{Node::Repeat};
+            repeat.min = min;
+            repeat.max = max;
+            if (!eof() && peek() == '?') {
+                repeat.greedy = false;
+                ++_pos;
+            }
+            repeat.children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+        return atom;
+    }
+
+    // Parse {n} {n,} or {n,m} at the position, the position is moved after
+    // it. Return false and keep the position if it isn't a counted
+    // quantifier.
+    bool parse_count(size_type& min, size_type& max)
+    {
+        auto pos = _pos + 1;
+        auto number = [&](size_type& n) {
+            auto begin = pos;
+            n = 0;
+            while (pos < _pattern.size() && is_digit(_pattern[pos])) {
+                n = n * 10 + (_pattern[pos++] - '0');
+                if (n > max_count)
+                    throw InvalidRegex("the count of repetition is too large");
+            }
+            return pos != begin;
+        };
+
+        if (!number(min))
+            return false;
+
+        max = min;
+        if (pos < _pattern.size() && _pattern[pos] == ',') {
+            ++pos;
+            if (!number(max))
+                max = npos;
+        }
+
+        if (pos >= _pattern.size() || _pattern[pos] != '}')
+            return false;
+
+        if (max < min)
+            throw InvalidRegex("the counts of repetition are out of order");
+
+        _pos = pos + 1;
+        return true;
+    }
+
+    Node parse_atom()
+    {
+        auto ch = _pattern[_pos++];
+        switch (ch) {
+            case '(': {
+                if (_depth == max_group_depth)
+                    throw InvalidRegex("the groups are nested too deeply");
+
+                Node group{Node::Group};
+                if (_pattern.substr(_pos, 2) == "?:") {
+                    _pos += 2;
+                } else {
+                    group.capture = true;
+                    group.index = _regex._groups++;
+                }
+                ++_depth;
+                group.children.push_back(parse_alternation());
+                --_depth;
+                if (eof())
+                    throw InvalidRegex("missing )");
+                ++_pos;
+                return group;
+            }
+            case '*':
+            case '+':
+            case '?':
+                throw InvalidRegex("nothing to repeat");
+            case '[':
+                return parse_class();
+            case '.':
+                return Node{Node::Any};
+            case '^':
+                return Node{Node::Begin};
+            case '$':
+                return Node{Node::End};
+            case '\\':
+                return parse_escape();
+            default:
+                return literal(ch);
+        }
+    }
+
+    Node parse_escape()
+    {
+        if (eof())
+            throw InvalidRegex("trailing backslash");
+
+        auto ch = _pattern[_pos++];
+        if (is_set_escape(ch))
+            return class_node(escape_set(ch));
+        if (ch == 'b')
+            return Node{Node::WordBoundary};
+        if (ch == 'B')
+            return Node{Node::NotWordBoundary};
+        return literal(escaped_char(ch));
+    }
+
+    // The character of \n \t and the escaped punctuation
+    static char escaped_char(char ch)
+    {
+        switch (ch) {
+            case 'n':
+                return '\n';
+            case 't':
+                return '\t';
+            case 'r':
+                return '\r';
+            case 'f':
+                return '\f';
+            case 'v':
+                return '\v';
+            case '0':
+                return '\0';
+            default:
+                if (std::isalnum(static_cast<unsigned char>(ch)))
+                    throw InvalidRegex(std::string("unknown escape \\") + ch);
+                return ch;
+        }
+    }
+
+    Node parse_class()
+    {
+        std::bitset<256> set;
+        bool negate = false;
+        if (!eof() && peek() == '^') {
+            negate = true;
+            ++_pos;
+        }
+
+        // The `]' at the beginning is a literal
+        for (bool first = true;; first = false) {
+            if (eof())
+                throw InvalidRegex("missing ]");
+
+            auto ch = _pattern[_pos++];
+            if (ch == ']' && !first)
+                break;
+
+            if (ch == '\\') {
+                if (eof())
+                    throw InvalidRegex("trailing backslash");
+                ch = _pattern[_pos++];
+                if (is_set_escape(ch)) {
+                    set |= escape_set(ch);
+                    continue;
+                }
+                ch = escaped_char(ch);
+            }
+
+            unsigned char lo = ch, hi = ch;
+            if (_pos + 1 < _pattern.size() && peek() == '-' &&
+                _pattern[_pos + 1] != ']') {
+                hi = _pattern[_pos + 1];
+                _pos += 2;
+                if (hi == '\\') {
+                    if (eof())
+                        throw InvalidRegex("trailing backslash");
+                    hi = escaped_char(_pattern[_pos++]);
+                }
+                if (hi < lo)
+                    throw InvalidRegex("the range of class is out of order");
+            }
+
+            for (unsigned c = lo; c <= hi; ++c)
+                set.set(c);
+        }
+
+        return class_node(negate ? ~set : set);
+    }
+
+    Node class_node(const std::bitset<256>& set)
+    {
+        Node node{Node::Class};
+        node.index = _regex._classes.size();
+        _regex._classes.push_back(set);
+        return node;
+    }
+
+    static Node literal(char ch)
+    {
+        Node node{Node::Char};
+        node.ch = ch;
+        return node;
+    }
+
+    // +--------------------+
+    //    Code Generation
+    // +--------------------+
+
+    size_type push(Instruction inst)
+    {
+        if (_regex._program.size() >= max_program_size)
+            throw InvalidRegex("the pattern is too large");
+
+        _regex._program.push_back(inst);
+        return _regex._program.size() - 1;
+    }
+
+    Instruction& at(size_type pc) { return _regex._program[pc]; }
+    size_type next() const { return _regex._program.size(); }
+
+    void emit(const Node& node)
+    {
+        switch (node.type) {
+            case Node::Char:
+                push({Opcode::Char, node.ch});
+                break;
+            case Node::Any:
+                push({Opcode::Any});
+                break;
+            case Node::Class:
+                push({Opcode::Class, 0, node.index});
+                break;
+            case Node::Begin:
+                push({Opcode::Begin});
+                break;
+            case Node::End:
+                push({Opcode::End});
+                break;
+            case Node::WordBoundary:
+                push({Opcode::WordBoundary});
+                break;
+            case Node::NotWordBoundary:
+                push({Opcode::NotWordBoundary});
+                break;
+            case Node::Concat:
+                for (const auto& child : node.children)
+                    emit(child);
+                break;
+            case Node::Group:
+                if (node.capture)
+                    push({Opcode::Save, 0, node.index * 2});
+                emit(node.children.front());
+                if (node.capture)
+                    push({Opcode::Save, 0, node.index * 2 + 1});
+                break;
+            case Node::Alternation:
+                emit_alternation(node);
+                break;
+            case Node::Repeat:
+                emit_repeat(node);
+                break;
+        }
+    }
+
+    // Split to the first alternative or to the rest, the first one is
+    // preferred
+    void emit_alternation(const Node& node)
+    {
+        std::vector<size_type> jumps;
+        for (size_type i = 0; i + 1 < node.children.size(); ++i) {
+            auto split = push({Opcode::Split});
+            at(split).x = next();
+            emit(node.children[i]);
+            jumps.push_back(push({Opcode::Jump}));
+            at(split).y = next();
+        }
+        emit(node.children.back());
+
+        for (auto jump : jumps)
+            at(jump).x = next();
+    }
+
+    // The operand is repeated min times, then it is optional for max - min
+    // times or in a loop if max is unbounded. The greedy one prefers to
+    // enter the operand and the lazy one prefers to leave.
+    void emit_repeat(const Node& node)
+    {
+        const auto& child = node.children.front();
+        for (size_type i = 0; i < node.min; ++i)
+            emit(child);
+
+        if (node.max == npos) {
+            auto split = push({Opcode::Split});
+            emit(child);
+            push({Opcode::Jump, 0, split});
+            link(split, node.greedy);
+            return;
+        }
+
+        std::vector<size_type> splits;
+        for (size_type i = node.min; i < node.max; ++i) {
+            splits.push_back(push({Opcode::Split}));
+            emit(child);
+        }
+        for (auto split : splits)
+            link(split, node.greedy);
+    }
+
+    void link(size_type split, bool greedy)
+    {
+        auto enter = split + 1, leave = next();
+        at(split).x = greedy ? enter : leave;
+        at(split).y = greedy ? leave : enter;
+    }
+};
+
+// +--------------------+
+//      Constructor
+// +--------------------+
+
+Regex::Regex(std::string_view pattern)
+  : _groups(1)
+{
+    Compiler(*this, pattern).compile();
+}
+
+// +--------------------+
+//    Public Functions
+// +--------------------+
+
+Regex::size_type
+Regex::groups() const
+{
+    return _groups;
+}
+
+bool
+Regex::match(std::string_view text, Match& result) const
+{
+    return run(text, 0, true, result);
+}
+
+bool
+Regex::search(std::string_view text, size_type pos, Match& result) const
+{
+    if (pos > text.size())
+        return false;
+    return run(text, pos, false, result);
+}
+
+// +--------------------+
+//   Private Functions
+// +--------------------+
+
+bool
+Regex::run(std::string_view text,
+           size_type start,
+           bool whole,
+           Match& result) const
+{
+    struct Thread
+    {
+        size_type pc;
+        Match slots;
+    };
+
+    const auto n = text.size();
+    std::vector<Thread> current, following, stack;
+    // The position where the instruction was added last time, so that every
+    // instruction has at most one thread at a position
+    std::vector<size_type> marks(_program.size(), npos);
+
+    // Follow the instructions which don't consume the text from pc, the
+    // threads stopped at the consuming ones are added to the list in the
+    // order of priority
+    auto add = [&](std::vector<Thread>& list,
+                   size_type pc,
+                   Match slots,
+                   size_type pos) {
+        stack.push_back({pc, std::move(slots)});
+        while (!stack.empty()) {
+            auto thread = std::move(stack.back());
+            stack.pop_back();
+            if (marks[thread.pc] == pos)
+                continue;
+            marks[thread.pc] = pos;
+
+            const auto& inst = _program[thread.pc];
+            auto next = thread.pc + 1;
+            bool before = pos > 0 && is_word(text[pos - 1]);
+            bool after = pos < n && is_word(text[pos]);
+            switch (inst.op) {
+                case Opcode::Jump:
+                    stack.push_back({inst.x, std::move(thread.slots)});
+                    break;
+                case Opcode::Split:
+                    stack.push_back({inst.y, thread.slots});
+                    stack.push_back({inst.x, std::move(thread.slots)});
+                    break;
+                case Opcode::Save:
+                    thread.slots[inst.x] = pos;
+                    stack.push_back({next, std::move(thread.slots)});
+                    break;
+                case Opcode::Begin:
+                    if (pos == 0)
+                        stack.push_back({next, std::move(thread.slots)});
+                    break;
+                case Opcode::End:
+                    if (pos == n)
+                        stack.push_back({next, std::move(thread.slots)});
+                    break;
+                case Opcode::WordBoundary:
+                    if (before != after)
+                        stack.push_back({next, std::move(thread.slots)});
+                    break;
+                case Opcode::NotWordBoundary:
+                    if (before == after)
+                        stack.push_back({next, std::move(thread.slots)});
+                    break;
+                default:
+                    list.push_back(std::move(thread));
+                    break;
+            }
+        }
+    };
+
+    bool matched = false;
+    const Match empty(_groups * 2, npos);
+    for (auto pos = start;; ++pos) {
+        // A new thread begins at every position until a match is found, it
+        // has lower priority than the threads began before
+        if (!matched && (pos == start || !whole))
+            add(current, 0, empty, pos);
+
+        // The search goes on when all the threads die before a match
+        if (current.empty() && (matched || whole))
+            break;
+
+        for (auto& thread : current) {
+            const auto& inst = _program[thread.pc];
+            if (inst.op == Opcode::Match) {
+                if (whole && pos != n)
+                    continue;
+                // The threads after it have lower priority
+                result = std::move(thread.slots);
+                matched = true;
+                break;
+            }
+
+            if (pos == n)
+                continue;
+
+            unsigned char ch = text[pos];
+            bool accepted = inst.op == Opcode::Char  ? ch == inst.ch
+                            : inst.op == Opcode::Any ? ch != '\n'
+                                                     : _classes[inst.x][ch];
+            if (accepted)
+                add(following, thread.pc + 1, std::move(thread.slots), pos + 1);
+        }
+
+        current.swap(following);
+        following.clear();
+        if (pos == n)
+            break;
+    }
+    return matched;
+}
+
+}
\ No newline at end of file
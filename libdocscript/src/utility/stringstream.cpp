@@ -90,6 +90,7 @@ StringStream::reset()
     _iter = _begin;
     _line_col_cnt = std::stack<Position::value_type>();
     _pos = Position(1, 1);
+    _mark = Mark();
 }
 
 void
@@ -156,6 +157,26 @@ StringStream::push_back(const std::string& str)
     _iter = _begin + diff;
 }
 
+void
+StringStream::mark()
+{
+    _mark.offset = _iter - _begin;
+    _mark.position = _pos;
+    _mark.line_cnt = _line_col_cnt.size();
+}
+
+void
+StringStream::rewind()
+{
+    // Only the lines passed after the mark need to be dropped, the counters
+    // before it are still valid.
+    while (_line_col_cnt.size() > _mark.line_cnt) {
+        _line_col_cnt.pop();
+    }
+    _iter = _begin + _mark.offset;
+    _pos = _mark.position;
+}
+
 // +------------------------+
 //      Type Conversions
 // +------------------------+